@@ -8,6 +8,9 @@
 #include <glm/glm.hpp>
 #include <GLFW/glfw3.h>
 
+#include "floatexp.h"
+#include "deuxdouble.h"
+
 constexpr int N_KEYS = 349;
  
 
@@ -35,6 +38,19 @@ public:
         bool zoomIn = false;
         bool zoomOut = false;
         bool reset_view = false; 
+
+        // mouse, accumulated between frames, (window pixels, y down)
+        double dragX = 0.;   // cursor motion while the left button is held
+        double dragY = 0.;
+        double scroll = 0.;  // wheel steps, > 0 zooms in
+        double scrollX = 0.; // cursor position at the last wheel step
+        double scrollY = 0.;
+
+        // smoothed velocity, view half-widths and ln(zoom) per second, 
+        // it coasts to a stop after the keys are released
+        double velX = 0.;
+        double velY = 0.;
+        double velZoom = 0.;
     };
 
 
@@ -42,12 +58,12 @@ public:
      * @brief the camera state of the screen.
      */
     struct Screen_Camera_t {
-        double cameraTranslationX = -1.9997740601362903593126807559602500475710416233856384007148508574291012335984591928248364190215796259575718318799960175396106897;// -0.8;
-        double cameraTranslationY = -0.000000003290040321479435053496978675926680596785294650587841008832604692785354945299105635268119663115032523417152566433535;// 0.;
-        double basePanningSpeed = 0.05;// 0.025;
-        double currentPanningSpeed = 0.025;
-        double cameraZoom = 1e0;
-        double zoomSpeed = 1.05f;
+        // double-double, the view is panned exactly at any zoom the double-double resolves
+        deuxDouble cameraTranslationX = -1.9997740601362903593126807559602500475710416233856384007148508574291012335984591928248364190215796259575718318799960175396106897;// -0.8;
+        deuxDouble cameraTranslationY = -0.000000003290040321479435053496978675926680596785294650587841008832604692785354945299105635268119663115032523417152566433535;// 0.;
+        double panSpeed = 1.5;     // view half-widths per second, (zoom independent)
+        floatExp cameraZoom = 1e0; // floatExp, zoom goes past the 1e308 limit of double
+        double zoomRate = 2.93;    // ln(zoom) per second, (x1.05 per frame at 60 fps)
     };
 
     Screen_Movement_t m_scrn_mov;
@@ -73,7 +89,7 @@ public:
      * This function handles the input events and updates the movement state
      * and r_iter_ value accordingly.
      */
-    void handle(int& r_iter_, bool& b_mode_, bool& b_xhair_);
+    void handle(int& r_iter_, bool& b_mode_, bool& b_xhair_, bool& b_julia_, bool& b_atlas_, bool& b_palette_, bool& b_equalise_);
 
     /**
      * @brief Checks the state of keys locally.
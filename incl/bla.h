@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+
+#include "perturbation.h"
+
+/**
+ * @brief Bilinear approximation of (2^level) perturbation steps.
+ *
+ *  dz_{n+L} = A * dz_n + B * dc, valid while |dz_n| < r
+ */
+struct Bla_Step_t {
+    double Ax = 0., Ay = 0.;
+    double Bx = 0., By = 0.;
+    double r = 0.;  ///< validity radius
+};
+
+/**
+ * @brief Bla_Step_t for the shader storage buffer.
+ *
+ *  Layout matches 'struct BlaStep { vec2 A; vec2 B; float r; }' (std430, 24 bytes).
+ */
+struct Bla_Gpu_Step_t {
+    float Ax, Ay;
+    float Bx, By;
+    float r;
+    float pad;
+};
+
+/**
+ * @brief BLA table, built level by level from the reference orbit.
+ *
+ *  Level 0 holds the single steps n -> n+1, entry i of level l merges
+ *  entries 2i and 2i+1 of level l-1, it starts at n = i * 2^l.
+ */
+struct Bla_Table_t {
+    std::vector<Bla_Step_t> steps;  ///< all levels, level 0 first
+    std::vector<int> level_offset;  ///< index of the first entry of each level
+    std::vector<int> level_count;   ///< number of entries of each level
+};
+
+/**
+ * @brief Builds the BLA table of a reference orbit.
+ *
+ * @param[in] orbit_  reference orbit
+ * @param[in] dc_max_  largest |dc| of the view
+ * @param[in] eps_  precision of the deltas, 2^-53 for double, 2^-24 for float
+ * @param[out] rout_table_  the table
+ */
+void build_bla_table(
+    const Ref_Orbit_t& orbit_,
+    double dc_max_,
+    double eps_,
+    Bla_Table_t& rout_table_);
+
+/**
+ * @brief Finds the longest valid BLA step starting at orbit index n_.
+ *
+ *  |dz| is given as (dz_norm2_ * 2^(2 * dz_exp_)), so rescaled deltas
+ *  can be tested without leaving their scale.
+ *
+ * @param[in] max_len_  longest step allowed, e.g. iterations left
+ * @param[out] rout_len_  number of iterations skipped
+ * @return the step, nullptr if none is valid
+ */
+auto bla_lookup(
+    const Bla_Table_t& table_,
+    int n_,
+    double dz_norm2_,
+    int dz_exp_,
+    int max_len_,
+    int& rout_len_)-> const Bla_Step_t*;
+
+/**
+ * @brief Converts the table to the float layout of the shader storage buffer.
+ */
+void bla_to_gpu(const Bla_Table_t& table_, std::vector<Bla_Gpu_Step_t>& rout_steps_);
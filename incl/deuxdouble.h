@@ -20,7 +20,7 @@ struct deuxDouble {
  * 
  * @return The sum, (dd0_ + dd1_)
  */
-deuxDouble dd_add(const deuxDouble& dd0_, const deuxDouble& dd1_) 
+inline deuxDouble dd_add(const deuxDouble& dd0_, const deuxDouble& dd1_) 
 {
     //-- TWO-SUM ( dd0_.val, dd1_.val) [Knuth]
     double _x = dd0_.val + dd1_.val;
@@ -51,7 +51,7 @@ deuxDouble dd_add(const deuxDouble& dd0_, const deuxDouble& dd1_)
  * 
  * @return The difference, (dd0_ - dd1_)
  */
-deuxDouble dd_sub(const deuxDouble& dd0_, const deuxDouble& dd1_)
+inline deuxDouble dd_sub(const deuxDouble& dd0_, const deuxDouble& dd1_)
 {
     double _x = dd0_.val - dd1_.val;
     double _dd1_val_virtual = _x - dd0_.val;
@@ -66,8 +66,55 @@ deuxDouble dd_sub(const deuxDouble& dd0_, const deuxDouble& dd1_)
 
 }
 
+/**
+ * @brief Function to multiply two Double2 variables
+ *
+ * @param dd0_ First double-double variable
+ * @param dd1_ Second double-double variable
+ *
+ * @return The product, (dd0_ * dd1_)
+ */
+inline deuxDouble dd_mul(const deuxDouble& dd0_, const deuxDouble& dd1_)
+{
+    //--- using SPLIT(a,s), s = 2^27 + 1 for double
+    double _cona = dd0_.val * 134217729.;
+    double _conb = dd1_.val * 134217729.;
+    double _a1 = _cona - (_cona - dd0_.val); // hi-split
+    double _b1 = _conb - (_conb - dd1_.val); // hi-split
+    double _a2 = dd0_.val - _a1; // lo-split
+    double _b2 = dd1_.val - _b1; // lo-split
+
+    //---  (_c11, _c21) is result of TWO-PRODUCT( dd0_.val, dd1_.val) [Dekker]
+    double _c11 = dd0_.val * dd1_.val;
+    double _c21 = (((_a1 * _b1 - _c11) + (_a1 * _b2)) + (_a2 * _b1)) + (_a2 * _b2);
+
+    //--- cross val-err products, only the high word is needed
+    double _c2 = (dd0_.val * dd1_.err) + (dd0_.err * dd1_.val);
+
+    // TWO-SUM( [_c11,_c21], [_c2,0])
+    double _t1 = _c2 + _c11;
+    double _e = _t1 - _c11;
+    double _t2 = ((_c2 - _e) + (_c11 - (_t1 - _e))) + _c21 + (dd0_.err * dd1_.err);
+
+    //--- FAST-TWO-SUM ( _t1, _t2)
+    deuxDouble _dd;
+    _dd.val = _t1 + _t2;
+    _dd.err = _t2 - (_dd.val - _t1);
 
+    return _dd;
+}
 
+/**
+ * @brief Negation of a double-double, (-dd_)
+ */
+inline deuxDouble dd_neg(const deuxDouble& dd_)
+{
+    deuxDouble _dd;
+    _dd.val = -dd_.val;
+    _dd.err = -dd_.err;
+    return _dd;
+}
 
-
-
+inline deuxDouble operator+(const deuxDouble& a_, const deuxDouble& b_) { return dd_add(a_, b_); }
+inline deuxDouble operator-(const deuxDouble& a_, const deuxDouble& b_) { return dd_sub(a_, b_); }
+inline deuxDouble operator*(const deuxDouble& a_, const deuxDouble& b_) { return dd_mul(a_, b_); }
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cmath>
+
+#include "deuxdouble.h"
+#include "quaddouble.h"
+#include "fixedpoint.h"
+#include "perturbation.h"
+
+//-----------------------------------------------------------
+// Number types of the escape-time kernel: float, double, deuxDouble,
+// quadDouble, fixedPoint<N>. Each provides T(double), +, -, *, and the
+// overloads below.
+
+inline double num_to_double(float f_) { return f_; }
+inline double num_to_double(double d_) { return d_; }
+inline double num_to_double(const deuxDouble& dd_) { return dd_.val + dd_.err; }
+inline double num_to_double(const quadDouble& qd_) { return qd_to_double(qd_); }
+template<int N>
+inline double num_to_double(const fixedPoint<N>& fx_) { return fx_to_double(fx_); }
+
+inline float num_abs(float f_) { return std::fabs(f_); }
+inline double num_abs(double d_) { return std::fabs(d_); }
+inline deuxDouble num_abs(const deuxDouble& dd_) { return (dd_.val < 0.) ? dd_neg(dd_) : dd_; }
+inline quadDouble num_abs(const quadDouble& qd_) { return (qd_.x[0] < 0.) ? qd_neg(qd_) : qd_; }
+template<int N>
+inline fixedPoint<N> num_abs(const fixedPoint<N>& fx_) { return fx_is_neg(fx_) ? fx_neg(fx_) : fx_; }
+
+//-----------------------------------------------------------
+// Formula policies.
+//
+//  init(): z and c of a pixel at p, (z starts at c, as in the shader)
+//  reuse_squares: the step only needs zx^2 and zy^2 besides z and c,
+//      the kernel then shares them with the |z|^2 escape test
+//      (the hadamard product of render_01_std()), step_squares() is used,
+//      otherwise step().
+
+/**
+ * @brief z = z^2 + c, c = pixel
+ */
+struct Mandelbrot_t {
+    static constexpr bool reuse_squares = true;
+
+    template<typename T>
+    void init(const T& px_, const T& py_, T& rout_zx_, T& rout_zy_, T& rout_cx_, T& rout_cy_) const
+    {
+        rout_cx_ = px_;
+        rout_cy_ = py_;
+        rout_zx_ = px_;
+        rout_zy_ = py_;
+    }
+
+    template<typename T>
+    void step_squares(T& rio_zx_, T& rio_zy_, const T& zozx_, const T& zozy_, const T& cx_, const T& cy_) const
+    {
+        T _zxy = rio_zx_ * rio_zy_;
+        rio_zy_ = (_zxy + _zxy) + cy_;
+        rio_zx_ = (zozx_ - zozy_) + cx_;
+    }
+};
+
+/**
+ * @brief z = z^2 + k, z starts at the pixel, k constant
+ */
+struct Julia_t : Mandelbrot_t {
+    double kx = 0.;
+    double ky = 0.;
+
+    Julia_t(double kx_, double ky_) : kx(kx_), ky(ky_) {}
+
+    template<typename T>
+    void init(const T& px_, const T& py_, T& rout_zx_, T& rout_zy_, T& rout_cx_, T& rout_cy_) const
+    {
+        rout_cx_ = T(kx);
+        rout_cy_ = T(ky);
+        rout_zx_ = px_;
+        rout_zy_ = py_;
+    }
+};
+
+/**
+ * @brief z = (|re z| + i |im z|)^2 + c
+ */
+struct Burning_Ship_t : Mandelbrot_t {
+    template<typename T>
+    void step_squares(T& rio_zx_, T& rio_zy_, const T& zozx_, const T& zozy_, const T& cx_, const T& cy_) const
+    {
+        // the squares are not affected by the absolute values, only the cross term is
+        T _zxy = num_abs(rio_zx_ * rio_zy_);
+        rio_zy_ = (_zxy + _zxy) + cy_;
+        rio_zx_ = (zozx_ - zozy_) + cx_;
+    }
+};
+
+/**
+ * @brief z = z^P + c, P >= 2
+ */
+template<int P>
+struct Multibrot_t : Mandelbrot_t {
+    static_assert(P >= 2, "Multibrot power must be at least 2");
+    static constexpr bool reuse_squares = false;
+
+    template<typename T>
+    void step(T& rio_zx_, T& rio_zy_, const T& cx_, const T& cy_) const
+    {
+        // z^P by repeated squaring, unrolled at compile time
+        T _bx = rio_zx_, _by = rio_zy_;
+        T _rx = T(1.), _ry = T(0.);
+        bool _b_first = true;
+
+        for (int _p = P; _p > 0; _p >>= 1) {
+            if (_p & 1) {
+                if (_b_first) {
+                    _rx = _bx;
+                    _ry = _by;
+                    _b_first = false;
+                } else {
+                    T _t = _rx * _bx - _ry * _by;
+                    _ry = _rx * _by + _ry * _bx;
+                    _rx = _t;
+                }
+            }
+            if (_p > 1) {
+                T _bxy = _bx * _by;
+                _bx = _bx * _bx - _by * _by;
+                _by = _bxy + _bxy;
+            }
+        }
+        rio_zx_ = _rx + cx_;
+        rio_zy_ = _ry + cy_;
+    }
+};
+
+//-----------------------------------------------------------
+
+/**
+ * @brief Escape-time iteration of one pixel, resolved at compile time for
+ *  the number type T and the formula, no dispatch inside the loop.
+ *
+ *  Same loop structure and iteration count as render_01_std() in the shader.
+ *
+ * @param[in] formula_  formula policy, Mandelbrot_t, Julia_t, ...
+ * @param[in] px_, py_  the pixel in the complex plane
+ * @param[in] max_iter_  iteration limit
+ *
+ * @return escape iteration and |z|^2, iter = -1 if bounded
+ */
+template<typename T, typename Formula>
+auto escape_time(const Formula& formula_, const T& px_, const T& py_, int max_iter_)-> Pixel_Result_t
+{
+    T _zx, _zy, _cx, _cy;
+    formula_.init(px_, py_, _zx, _zy, _cx, _cy);
+
+    Pixel_Result_t _px;
+
+    if constexpr (Formula::reuse_squares) {
+        // hadamard product z o z, shared by |z|^2 and the next step
+        T _zozx = _zx * _zx;
+        T _zozy = _zy * _zy;
+
+        for (int _iter = 0; _iter < max_iter_; ++_iter) {
+            double _dist = num_to_double(_zozx + _zozy);
+
+            if (_dist > 4.) {
+                _px.iter = _iter;
+                _px.dist2 = static_cast<float>(_dist);
+                break;
+            }
+
+            formula_.step_squares(_zx, _zy, _zozx, _zozy, _cx, _cy);
+            _zozx = _zx * _zx;
+            _zozy = _zy * _zy;
+        }
+    }
+    else {
+        for (int _iter = 0; _iter < max_iter_; ++_iter) {
+            double _dist = num_to_double(_zx * _zx + _zy * _zy);
+
+            if (_dist > 4.) {
+                _px.iter = _iter;
+                _px.dist2 = static_cast<float>(_dist);
+                break;
+            }
+
+            formula_.step(_zx, _zy, _cx, _cy);
+        }
+    }
+    return _px;
+}
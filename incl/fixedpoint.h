@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+#include "deuxdouble.h"
+
+
+/**
+ * @brief Fixed-point real of N 32-bit limbs, two's complement.
+ *
+ *  value = (signed integer of the limbs) * 2^(-32 * (N - 1))
+ *
+ *  The most significant limb holds the integer part, the others hold
+ *  (32 * (N - 1)) fraction bits. Precision does not depend on magnitude,
+ *  slow, but exact to the last bit: the reference when measuring the
+ *  precision of the other number types.
+ */
+template<int N>
+struct fixedPoint {
+    static_assert(N >= 2, "fixedPoint needs an integer and a fraction limb");
+
+    std::uint32_t limb[N] = {}; ///< least significant first
+
+    fixedPoint() {}
+    fixedPoint(double d_);
+    fixedPoint(const deuxDouble& dd_);
+};
+
+/**
+ * @brief Sign of a fixedPoint
+ */
+template<int N>
+inline bool fx_is_neg(const fixedPoint<N>& fx_)
+{
+    return (fx_.limb[N - 1] & 0x80000000u) != 0;
+}
+
+/**
+ * @brief Negation of a fixedPoint, (-fx_)
+ */
+template<int N>
+inline fixedPoint<N> fx_neg(const fixedPoint<N>& fx_)
+{
+    fixedPoint<N> _r;
+    std::uint64_t _carry = 1;
+    for (int _i = 0; _i < N; ++_i) {
+        std::uint64_t _t = std::uint64_t(~fx_.limb[_i]) + _carry;
+        _r.limb[_i] = static_cast<std::uint32_t>(_t);
+        _carry = _t >> 32;
+    }
+    return _r;
+}
+
+/**
+ * @brief Function to add two fixedPoint variables
+ *
+ * @return The sum, (fx0_ + fx1_)
+ */
+template<int N>
+inline fixedPoint<N> fx_add(const fixedPoint<N>& fx0_, const fixedPoint<N>& fx1_)
+{
+    fixedPoint<N> _r;
+    std::uint64_t _carry = 0;
+    for (int _i = 0; _i < N; ++_i) {
+        std::uint64_t _t = std::uint64_t(fx0_.limb[_i]) + fx1_.limb[_i] + _carry;
+        _r.limb[_i] = static_cast<std::uint32_t>(_t);
+        _carry = _t >> 32;
+    }
+    return _r;
+}
+
+/**
+ * @brief Function to subtract two fixedPoint variables
+ *
+ * @return The difference, (fx0_ - fx1_)
+ */
+template<int N>
+inline fixedPoint<N> fx_sub(const fixedPoint<N>& fx0_, const fixedPoint<N>& fx1_)
+{
+    fixedPoint<N> _r;
+    std::uint64_t _borrow = 0;
+    for (int _i = 0; _i < N; ++_i) {
+        std::uint64_t _t = std::uint64_t(fx0_.limb[_i]) - fx1_.limb[_i] - _borrow;
+        _r.limb[_i] = static_cast<std::uint32_t>(_t);
+        _borrow = (_t >> 63) & 1;
+    }
+    return _r;
+}
+
+/**
+ * @brief Function to multiply two fixedPoint variables,
+ *  the fraction bits below the last limb are truncated.
+ *
+ * @return The product, (fx0_ * fx1_)
+ */
+template<int N>
+inline fixedPoint<N> fx_mul(const fixedPoint<N>& fx0_, const fixedPoint<N>& fx1_)
+{
+    const bool _b_neg = fx_is_neg(fx0_) != fx_is_neg(fx1_);
+    const fixedPoint<N> _a = fx_is_neg(fx0_) ? fx_neg(fx0_) : fx0_;
+    const fixedPoint<N> _b = fx_is_neg(fx1_) ? fx_neg(fx1_) : fx1_;
+
+    // schoolbook product of the magnitudes, 2N limbs
+    std::uint32_t _p[2 * N] = {};
+    for (int _i = 0; _i < N; ++_i) {
+        std::uint64_t _carry = 0;
+        for (int _j = 0; _j < N; ++_j) {
+            std::uint64_t _t = std::uint64_t(_a.limb[_i]) * _b.limb[_j] + _p[_i + _j] + _carry;
+            _p[_i + _j] = static_cast<std::uint32_t>(_t);
+            _carry = _t >> 32;
+        }
+        _p[_i + N] = static_cast<std::uint32_t>(_carry);
+    }
+
+    // back to (N - 1) fraction limbs
+    fixedPoint<N> _r;
+    for (int _i = 0; _i < N; ++_i) {
+        _r.limb[_i] = _p[_i + N - 1];
+    }
+    return _b_neg ? fx_neg(_r) : _r;
+}
+
+/**
+ * @brief Convert to double, rounded
+ */
+template<int N>
+inline double fx_to_double(const fixedPoint<N>& fx_)
+{
+    const bool _b_neg = fx_is_neg(fx_);
+    const fixedPoint<N> _m = _b_neg ? fx_neg(fx_) : fx_;
+
+    // from the least significant limb, the rounding is done by the last addition
+    double _d = 0.;
+    for (int _i = 0; _i < N; ++_i) {
+        _d += std::ldexp(double(_m.limb[_i]), 32 * (_i - (N - 1)));
+    }
+    return _b_neg ? -_d : _d;
+}
+
+/**
+ * @brief Exact conversion from double, |d_| < 2^31
+ */
+template<int N>
+inline fixedPoint<N>::fixedPoint(double d_)
+{
+    double _x = std::fabs(d_);
+    for (int _i = N - 1; _i >= 0; --_i) {
+        double _l = std::floor(_x);
+        limb[_i] = static_cast<std::uint32_t>(_l);
+        _x = (_x - _l) * 4294967296.;
+    }
+    if (d_ < 0.) {
+        *this = fx_neg(*this);
+    }
+}
+
+/**
+ * @brief Exact conversion from double-double
+ */
+template<int N>
+inline fixedPoint<N>::fixedPoint(const deuxDouble& dd_)
+{
+    *this = fx_add(fixedPoint<N>(dd_.val), fixedPoint<N>(dd_.err));
+}
+
+template<int N> inline fixedPoint<N> operator+(const fixedPoint<N>& a_, const fixedPoint<N>& b_) { return fx_add(a_, b_); }
+template<int N> inline fixedPoint<N> operator-(const fixedPoint<N>& a_, const fixedPoint<N>& b_) { return fx_sub(a_, b_); }
+template<int N> inline fixedPoint<N> operator*(const fixedPoint<N>& a_, const fixedPoint<N>& b_) { return fx_mul(a_, b_); }
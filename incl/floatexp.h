@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cmath>
+
+
+/**
+ * @brief Extended-exponent float, a double mantissa with a separate exponent.
+ *
+ *  value = mant * 2^exp, with |mant| in [0.5, 1), or mant == 0.
+ *
+ *  Precision stays at 53 bits, but the range is no longer bounded by
+ *  the 11-bit exponent of double (1e-308 .. 1e+308). Used for the zoom
+ *  scale and the perturbation deltas once they underflow double.
+ */
+struct floatExp {
+    double mant = 0.;
+    int    exp = 0; ///< binary exponent
+
+    floatExp() {}
+    floatExp(double d_) { mant = std::frexp(d_, &exp); }
+    floatExp(double mant_, int exp_) { mant = std::frexp(mant_, &exp); exp = (mant == 0.) ? 0 : exp + exp_; }
+};
+
+/**
+ * @brief Convert to double, underflows to 0 (or overflows to inf) outside the double range
+ */
+inline double fe_to_double(const floatExp& fe_)
+{
+    return std::ldexp(fe_.mant, fe_.exp);
+}
+
+/**
+ * @brief log2 of the absolute value, valid far outside the double range
+ */
+inline double fe_log2(const floatExp& fe_)
+{
+    return std::log2(std::fabs(fe_.mant)) + fe_.exp;
+}
+
+/**
+ * @brief Function to add two floatExp variables
+ *
+ * @return The sum, (fe0_ + fe1_)
+ */
+inline floatExp fe_add(const floatExp& fe0_, const floatExp& fe1_)
+{
+    if (fe0_.mant == 0.) {
+        return fe1_;
+    }
+    if (fe1_.mant == 0.) {
+        return fe0_;
+    }
+
+    // align to the larger exponent, the smaller term drops out beyond 53+ bits
+    if (fe0_.exp >= fe1_.exp) {
+        int _d = fe0_.exp - fe1_.exp;
+        return (_d > 64) ? fe0_ : floatExp(fe0_.mant + std::ldexp(fe1_.mant, -_d), fe0_.exp);
+    }
+    int _d = fe1_.exp - fe0_.exp;
+    return (_d > 64) ? fe1_ : floatExp(fe1_.mant + std::ldexp(fe0_.mant, -_d), fe1_.exp);
+}
+
+/**
+ * @brief Function to subtract two floatExp variables
+ *
+ * @return The difference, (fe0_ - fe1_)
+ */
+inline floatExp fe_sub(const floatExp& fe0_, const floatExp& fe1_)
+{
+    floatExp _neg = fe1_;
+    _neg.mant = -_neg.mant;
+    return fe_add(fe0_, _neg);
+}
+
+/**
+ * @brief Function to multiply two floatExp variables
+ *
+ * @return The product, (fe0_ * fe1_)
+ */
+inline floatExp fe_mul(const floatExp& fe0_, const floatExp& fe1_)
+{
+    return floatExp(fe0_.mant * fe1_.mant, fe0_.exp + fe1_.exp);
+}
+
+/**
+ * @brief Function to divide two floatExp variables
+ *
+ * @return The quotient, (fe0_ / fe1_)
+ */
+inline floatExp fe_div(const floatExp& fe0_, const floatExp& fe1_)
+{
+    return floatExp(fe0_.mant / fe1_.mant, fe0_.exp - fe1_.exp);
+}
+
+/**
+ * @brief Compare two floatExp variables
+ *
+ * @return <0, 0, >0 for (fe0_ < fe1_), (fe0_ == fe1_), (fe0_ > fe1_)
+ */
+inline int fe_cmp(const floatExp& fe0_, const floatExp& fe1_)
+{
+    floatExp _d = fe_sub(fe0_, fe1_);
+    return (_d.mant > 0.) - (_d.mant < 0.);
+}
+
+// Operators, so the camera code reads the same as with plain double
+inline floatExp operator+(const floatExp& a_, const floatExp& b_) { return fe_add(a_, b_); }
+inline floatExp operator-(const floatExp& a_, const floatExp& b_) { return fe_sub(a_, b_); }
+inline floatExp operator*(const floatExp& a_, const floatExp& b_) { return fe_mul(a_, b_); }
+inline floatExp operator/(const floatExp& a_, const floatExp& b_) { return fe_div(a_, b_); }
+inline bool operator<(const floatExp& a_, const floatExp& b_) { return fe_cmp(a_, b_) < 0; }
+inline bool operator>(const floatExp& a_, const floatExp& b_) { return fe_cmp(a_, b_) > 0; }
+inline bool operator<=(const floatExp& a_, const floatExp& b_) { return fe_cmp(a_, b_) <= 0; }
+inline bool operator>=(const floatExp& a_, const floatExp& b_) { return fe_cmp(a_, b_) >= 0; }
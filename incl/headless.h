@@ -0,0 +1,13 @@
+#pragma once
+
+/**
+ * @brief Entry point for command-line (window-less) operation.
+ *
+ *  mandlebrot --render <cx> <cy> <zoom> <max_iter> <wd> <ht> <out.ppm> [--equalise]
+ *  mandlebrot --precision <cx> <cy> <zoom> <max_iter> <wd> <ht> <out_prefix>
+ *  mandlebrot --direct <type> <formula> <cx> <cy> <zoom> <max_iter> <wd> <ht> <out.ppm>
+ *  mandlebrot --julia-atlas <cx> <cy> <view_width> <max_iter> <grid> <cell_px> <out.ppm>
+ *
+ * @return process exit code
+ */
+int run_headless(int argc, char** argv);
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+class Shader;
+
+
+/**
+ * @brief Lattice of Julia constants around a point of the Mandelbrot map.
+ *
+ *  c(i, j) = ((k0x + i) * spacing, (k0y + j) * spacing), i, j in [0, grid)
+ *  j = 0 is the bottom row. The spacing is a power of 2, so the lattice
+ *  points are exact doubles and stay the same while panning and zooming
+ *  within an octave, (they are the keys of the atlas cache).
+ */
+struct Julia_Lattice_t {
+    int grid = 8;
+    double spacing = 0.5;
+    double k0x = 0.;
+    double k0y = 0.;
+
+    double cx(int i_) const { return (k0x + i_) * spacing; }
+    double cy(int j_) const { return (k0y + j_) * spacing; }
+};
+
+/**
+ * @brief Lattice of (grid_ x grid_) constants centred on (cx_, cy_), about view_width_ wide.
+ */
+inline Julia_Lattice_t julia_lattice(double cx_, double cy_, double view_width_, int grid_)
+{
+    Julia_Lattice_t _lattice;
+    _lattice.grid = grid_;
+    _lattice.spacing = std::exp2(std::floor(std::log2(view_width_ / grid_)));
+    _lattice.k0x = std::round(cx_ / _lattice.spacing) - grid_ / 2;
+    _lattice.k0y = std::round(cy_ / _lattice.spacing) - grid_ / 2;
+    return _lattice;
+}
+
+/**
+ * @brief Julia set thumbnails of a lattice of constants, in an atlas texture.
+ *
+ *  The thumbnails not already in the atlas are rendered together, in one
+ *  instanced draw, an instance per thumbnail. The atlas holds twice the
+ *  lattice, the slots are reused least recently used first, so panning
+ *  back and forth only renders the new lattice cells.
+ *
+ *  Each thumbnail shows the Julia set over [-2, 2]^2, in single precision.
+ *  The atlas holds the iterations, the caller colours them into colour_FBO(),
+ *  with the colouring pass of the view, (palette and equalisation).
+ */
+class Julia_Atlas {
+
+public:
+    Julia_Atlas(int grid_, int cell_px_);
+    ~Julia_Atlas();
+
+    Julia_Atlas(const Julia_Atlas&) = delete;
+    Julia_Atlas& operator=(const Julia_Atlas&) = delete;
+
+    /**
+     * @brief Bring the atlas up to the lattice around (cx_, cy_), rendering
+     *  the missing thumbnails. Changes the framebuffer binding and viewport.
+     *
+     * @return the number of thumbnails rendered
+     */
+    auto update(double cx_, double cy_, double view_width_, int max_iter_)-> int;
+
+    /**
+     * @brief Iteration atlas, RG32F, (escape iteration, |z|^2), (-1, 0) if bounded.
+     */
+    auto iter_texture() const-> unsigned int { return m_iter_texture; }
+
+    /**
+     * @brief Framebuffer of the colours of the atlas, drawn by draw().
+     */
+    auto colour_FBO() const-> unsigned int { return m_FBO; }
+
+    auto width() const-> int { return m_slots_x * m_cell_px; }
+    auto height() const-> int { return m_slots_y * m_cell_px; }
+
+    /**
+     * @brief Draw the lattice, (grid x grid) thumbnails over the (wd_ x ht_)
+     *  default framebuffer.
+     */
+    void draw(int wd_, int ht_) const;
+
+private:
+    struct Slot_t {
+        double cx = 0.;
+        double cy = 0.;
+        std::uint64_t last_used = 0;
+        bool b_valid = false;
+    };
+
+    int m_grid;
+    int m_cell_px;
+    int m_slots_x;  // slots per row of the atlas
+    int m_slots_y;
+    int m_max_iter = 0;
+
+    std::vector<Slot_t> m_slots;
+    std::map<std::pair<double, double>, int> m_slot_of_c;
+    std::vector<int> m_lattice_slots; // slot of each lattice cell, j * grid + i
+    std::uint64_t m_update_count = 0;
+
+    Shader* mp_shader = nullptr;
+
+    unsigned int m_iter_texture = 0;
+    unsigned int m_iter_FBO = 0;
+    unsigned int m_texture = 0;     // colours
+    unsigned int m_FBO = 0;
+    unsigned int m_VAO = 0;
+    unsigned int m_VBO = 0;
+    unsigned int m_EBO = 0;
+    unsigned int m_instance_VBO = 0;
+
+    void x_setup_buffers();
+    void x_clear_iterations();
+    auto x_acquire_slot()-> int;
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <filesystem>
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "perturbation.h"
+
+/**
+ * @brief On-disk cache of reference orbits, one memory-mapped file per orbit.
+ *
+ *  Keyed by (centre, precision of the reference arithmetic), a file serves
+ *  any iteration limit up to its own. It holds the double-rounded points for
+ *  the GPU upload, and the last z in full precision so that the orbit can be
+ *  extended later, the extended orbit then replaces the file of the shorter one.
+ *  Least recently used files are evicted once the cache grows past its budget,
+ *  the order is kept across runs through the file modification times.
+ */
+class Orbit_Cache
+{
+public:
+    Orbit_Cache(const std::filesystem::path& dir_, std::uintmax_t max_bytes_);
+
+    Orbit_Cache(const Orbit_Cache&) = delete;
+    Orbit_Cache& operator=(const Orbit_Cache&) = delete;
+
+    auto load(
+        const deuxDouble& cx_,
+        const deuxDouble& cy_,
+        int max_iter_,
+        Ref_Orbit_t& rout_orbit_)-> bool;
+
+    void store(const Ref_Orbit_t& orbit_);
+
+private:
+    struct Entry_t {
+        std::string name;       ///< file name in m_dir
+        std::uintmax_t bytes;   ///< file size
+    };
+
+    std::filesystem::path m_dir;
+    std::uintmax_t m_max_bytes;
+    std::uintmax_t m_total_bytes = 0;
+
+    std::list<Entry_t> m_lru;   ///< most recently used first
+    std::unordered_map<std::string, std::list<Entry_t>::iterator> m_index;
+
+    void x_scan();
+    void x_touch(const std::string& name_);
+    void x_insert(const std::string& name_, std::uintmax_t bytes_);
+    void x_remove(const std::string& name_);
+    void x_evict();
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Entries of a palette, the colouring pass interpolates linearly between
+// them, and wraps around: the palette is one colour cycle.
+constexpr int PALETTE_SIZE = 256;
+
+/**
+ * @brief Colour stop of a gradient palette, t in [0, 1).
+ *
+ *  The gradient wraps from the last stop back to the first.
+ */
+struct Palette_Stop_t {
+    float t;
+    float rgb[3];
+};
+
+// Baked gradient palettes, (palette 0 is the cosine palette of colorFunc2)
+constexpr Palette_Stop_t PALETTE_FIRE[] = {
+    { 0.00f, { 0.00f, 0.00f, 0.00f } },
+    { 0.25f, { 0.60f, 0.05f, 0.00f } },
+    { 0.50f, { 1.00f, 0.55f, 0.00f } },
+    { 0.75f, { 1.00f, 0.95f, 0.60f } },
+};
+
+constexpr Palette_Stop_t PALETTE_OCEAN[] = {
+    { 0.00f, { 0.00f, 0.03f, 0.20f } },
+    { 0.30f, { 0.00f, 0.40f, 0.70f } },
+    { 0.55f, { 0.85f, 0.95f, 1.00f } },
+    { 0.80f, { 0.10f, 0.60f, 0.55f } },
+};
+
+constexpr Palette_Stop_t PALETTE_GREY[] = {
+    { 0.00f, { 0.05f, 0.05f, 0.05f } },
+    { 0.50f, { 0.95f, 0.95f, 0.95f } },
+};
+
+constexpr int N_PALETTES = 4;
+
+/**
+ * @brief Builds palette palette_, [0, N_PALETTES), PALETTE_SIZE RGB entries.
+ */
+void build_palette(int palette_, std::vector<float>& rout_rgb_);
+
+/**
+ * @brief Palette coordinate of an escaped pixel, smooth iteration count,
+ *  one colour cycle per unit.
+ *
+ *  Same colour cycle as colorFunc2(): 0.5 + 0.5 * cos(2.7 + 30 * sl + offset)
+ */
+auto palette_coord(int iter_, float dist2_)-> float;
+
+/**
+ * @brief Palette colour at t_, as sampled by the colouring pass
+ *  (linear filter, repeat wrap).
+ */
+void palette_lookup(const std::vector<float>& rgb_, float t_, float* rout_rgb_);
+
+//-----------------------------------------------------------
+// Histogram equalisation: the palette coordinate of a pixel is the share
+// of the escaped pixels that escaped before it, so the colours spread over
+// the iterations the view actually has, however narrow their band.
+
+// Bins of the iteration histogram, [0, max_iter) in equal parts,
+// (one iteration per bin up to 4096 iterations)
+constexpr int HISTOGRAM_BINS = 4096;
+
+/**
+ * @brief Histogram bin of an escape iteration.
+ */
+inline int histogram_bin(int iter_, int max_iter_)
+{
+    int _bin = static_cast<int>(std::int64_t(iter_) * HISTOGRAM_BINS / max_iter_);
+    return (_bin < HISTOGRAM_BINS - 1) ? _bin : HISTOGRAM_BINS - 1;
+}
+
+/**
+ * @brief CDF of a histogram, inclusive prefix sum normalised to the total.
+ */
+void build_cdf(const std::vector<std::uint32_t>& bins_, std::vector<float>& rout_cdf_);
+
+/**
+ * @brief Palette coordinate of an escaped pixel, equalised, in [0, 1].
+ *
+ *  The CDF is interpolated inside the bin by the smooth iteration count.
+ */
+auto equalised_coord(int iter_, float dist2_, int max_iter_, const std::vector<float>& cdf_)-> float;
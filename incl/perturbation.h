@@ -0,0 +1,106 @@
+#pragma once
+
+#include <vector>
+
+#include "deuxdouble.h"
+#include "floatexp.h"
+
+struct Bla_Table_t;
+
+/**
+ * @brief A point of the reference orbit, Z_n rounded to double.
+ *
+ *  Layout matches 'dvec2' in the shader storage buffer (std430).
+ */
+struct Orbit_Point_t {
+    double x = 0.;
+    double y = 0.;
+};
+
+/**
+ * @brief Reference orbit for perturbation rendering.
+ *
+ *  Computed once, in high precision, at the view centre. Every other
+ *  pixel only iterates its (small) delta against this orbit.
+ */
+struct Ref_Orbit_t {
+    deuxDouble cx, cy;      ///< reference point c
+    deuxDouble zx, zy;      ///< last z in full precision
+    int  max_iter = 0;      ///< iteration limit the orbit was computed for
+    bool escaped = false;   ///< orbit escaped before max_iter
+    std::vector<Orbit_Point_t> points; ///< Z_0 = 0, Z_1 = c, ..., Z_n
+};
+
+/**
+ * @brief View of the complex plane, for CPU rendering.
+ */
+struct Plane_View_t {
+    deuxDouble cx, cy;  ///< view centre
+    floatExp radius;    ///< half-width of the view, (2 / cameraZoom)
+    int wd = 0;         ///< width in pixels
+    int ht = 0;         ///< height in pixels
+};
+
+/**
+ * @brief Per-pixel escape result.
+ */
+struct Pixel_Result_t {
+    int   iter = -1;    ///< escape iteration, -1 if still bounded at max_iter
+    float dist2 = 0.f;  ///< |z|^2 at escape, or |z|^2 / |Z|^2 if glitched
+    bool  glitched = false; ///< pixel orbit lost track of the reference orbit
+};
+
+/**
+ * @brief Statistics of a CPU render.
+ */
+struct Render_Stats_t {
+    int n_references = 0;   ///< reference orbits used, including the primary
+    int n_glitched = 0;     ///< pixels left glitched
+};
+
+/**
+ * @brief Computes the reference orbit at c = (cx_, cy_) in double-double.
+ */
+void compute_reference_orbit(
+    const deuxDouble& cx_,
+    const deuxDouble& cy_,
+    int max_iter_,
+    Ref_Orbit_t& rout_orbit_);
+
+/**
+ * @brief Extends the orbit to max_iter_, from its last z, without recomputing it.
+ */
+void extend_reference_orbit(int max_iter_, Ref_Orbit_t& rio_orbit_);
+
+/**
+ * @brief Iterates one pixel, at offset (dcx_, dcy_) from the reference point.
+ *
+ *  Deltas stay in double while they fit, otherwise they are iterated
+ *  rescaled (mantissa near 1 + shared exponent), and handed back to
+ *  double once they grow into its range.
+ *
+ *  Glitches are detected with Pauldelbrot's criterion, |z|^2 < tol * |Z|^2,
+ *  the pixel then needs a reference orbit closer to it.
+ *
+ *  With a BLA table (bla_ != nullptr), runs of iterations are skipped
+ *  wherever the bilinear approximation holds.
+ */
+auto perturb_pixel(
+    const Ref_Orbit_t& orbit_,
+    const Bla_Table_t* bla_,
+    const floatExp& dcx_,
+    const floatExp& dcy_,
+    int max_iter_)-> Pixel_Result_t;
+
+/**
+ * @brief Renders a view on the CPU, one thread per hardware core.
+ *
+ *  Glitched pixels are grouped into connected regions, each region gets a
+ *  secondary reference orbit and only its pixels are re-rendered.
+ *  Rows are stored top to bottom, rout_pixels_ is resized to (wd x ht).
+ */
+auto render_perturbation_cpu(
+    const Ref_Orbit_t& orbit_,
+    const Plane_View_t& view_,
+    int max_iter_,
+    std::vector<Pixel_Result_t>& rout_pixels_)-> Render_Stats_t;
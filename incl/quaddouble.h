@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cmath>
+
+
+/**
+ * @brief Quad-double, an unevaluated sum of four doubles, about 212 bits.
+ *
+ *  value = x[0] + x[1] + x[2] + x[3], with |x[i+1]| <= ulp(x[i]) / 2.
+ *  The arithmetic follows the "sloppy" algorithms of Hida, Li & Bailey's
+ *  QD library.
+ */
+struct quadDouble {
+    double x[4] = { 0., 0., 0., 0. };
+
+    quadDouble() {}
+    quadDouble(double d_) { x[0] = d_; }
+    quadDouble(double x0_, double x1_, double x2_, double x3_) { x[0] = x0_; x[1] = x1_; x[2] = x2_; x[3] = x3_; }
+};
+
+namespace qd_detail {
+
+//--- FAST-TWO-SUM (a, b) [Dekker], |a| >= |b|
+inline double quick_two_sum(double a_, double b_, double& rout_err_)
+{
+    double _s = a_ + b_;
+    rout_err_ = b_ - (_s - a_);
+    return _s;
+}
+
+//--- TWO-SUM (a, b) [Knuth]
+inline double two_sum(double a_, double b_, double& rout_err_)
+{
+    double _s = a_ + b_;
+    double _bb = _s - a_;
+    rout_err_ = (a_ - (_s - _bb)) + (b_ - _bb);
+    return _s;
+}
+
+//--- TWO-PRODUCT (a, b), exact with a fused multiply-add
+inline double two_prod(double a_, double b_, double& rout_err_)
+{
+    double _p = a_ * b_;
+    rout_err_ = std::fma(a_, b_, -_p);
+    return _p;
+}
+
+inline void three_sum(double& a_, double& b_, double& c_)
+{
+    double _t2, _t3;
+    double _t1 = two_sum(a_, b_, _t2);
+    a_ = two_sum(c_, _t1, _t3);
+    b_ = two_sum(_t2, _t3, c_);
+}
+
+inline void three_sum2(double& a_, double& b_, double& c_)
+{
+    double _t2, _t3;
+    double _t1 = two_sum(a_, b_, _t2);
+    a_ = two_sum(c_, _t1, _t3);
+    b_ = _t2 + _t3;
+}
+
+/**
+ * @brief Renormalise five overlapping terms into four.
+ */
+inline void renorm(double& c0_, double& c1_, double& c2_, double& c3_, double& c4_)
+{
+    if (std::isinf(c0_)) {
+        return;
+    }
+
+    double _s0, _s1, _s2 = 0., _s3 = 0.;
+
+    _s0 = quick_two_sum(c3_, c4_, c4_);
+    _s0 = quick_two_sum(c2_, _s0, c3_);
+    _s0 = quick_two_sum(c1_, _s0, c2_);
+    c0_ = quick_two_sum(c0_, _s0, c1_);
+
+    _s0 = c0_;
+    _s1 = c1_;
+
+    if (_s1 != 0.) {
+        _s1 = quick_two_sum(_s1, c2_, _s2);
+        if (_s2 != 0.) {
+            _s2 = quick_two_sum(_s2, c3_, _s3);
+            if (_s3 != 0.) {
+                _s3 += c4_;
+            } else {
+                _s2 += c4_;
+            }
+        } else {
+            _s1 = quick_two_sum(_s1, c3_, _s2);
+            if (_s2 != 0.) {
+                _s2 = quick_two_sum(_s2, c4_, _s3);
+            } else {
+                _s1 = quick_two_sum(_s1, c4_, _s2);
+            }
+        }
+    } else {
+        _s0 = quick_two_sum(_s0, c2_, _s1);
+        if (_s1 != 0.) {
+            _s1 = quick_two_sum(_s1, c3_, _s2);
+            if (_s2 != 0.) {
+                _s2 = quick_two_sum(_s2, c4_, _s3);
+            } else {
+                _s1 = quick_two_sum(_s1, c4_, _s2);
+            }
+        } else {
+            _s0 = quick_two_sum(_s0, c3_, _s1);
+            if (_s1 != 0.) {
+                _s1 = quick_two_sum(_s1, c4_, _s2);
+            } else {
+                _s0 = quick_two_sum(_s0, c4_, _s1);
+            }
+        }
+    }
+
+    c0_ = _s0;
+    c1_ = _s1;
+    c2_ = _s2;
+    c3_ = _s3;
+}
+
+} // namespace qd_detail
+
+/**
+ * @brief Negation of a quad-double, (-qd_)
+ */
+inline quadDouble qd_neg(const quadDouble& qd_)
+{
+    return quadDouble(-qd_.x[0], -qd_.x[1], -qd_.x[2], -qd_.x[3]);
+}
+
+/**
+ * @brief Function to add two quad-double variables
+ *
+ * @return The sum, (qd0_ + qd1_)
+ */
+inline quadDouble qd_add(const quadDouble& qd0_, const quadDouble& qd1_)
+{
+    using namespace qd_detail;
+
+    double _t0, _t1, _t2, _t3;
+    double _s0 = two_sum(qd0_.x[0], qd1_.x[0], _t0);
+    double _s1 = two_sum(qd0_.x[1], qd1_.x[1], _t1);
+    double _s2 = two_sum(qd0_.x[2], qd1_.x[2], _t2);
+    double _s3 = two_sum(qd0_.x[3], qd1_.x[3], _t3);
+
+    _s1 = two_sum(_s1, _t0, _t0);
+    three_sum(_s2, _t0, _t1);
+    three_sum2(_s3, _t0, _t2);
+    _t0 = _t0 + _t1 + _t3;
+
+    renorm(_s0, _s1, _s2, _s3, _t0);
+    return quadDouble(_s0, _s1, _s2, _s3);
+}
+
+/**
+ * @brief Function to subtract two quad-double variables
+ *
+ * @return The difference, (qd0_ - qd1_)
+ */
+inline quadDouble qd_sub(const quadDouble& qd0_, const quadDouble& qd1_)
+{
+    return qd_add(qd0_, qd_neg(qd1_));
+}
+
+/**
+ * @brief Function to multiply two quad-double variables,
+ *  terms below O(eps^3) are dropped.
+ *
+ * @return The product, (qd0_ * qd1_)
+ */
+inline quadDouble qd_mul(const quadDouble& qd0_, const quadDouble& qd1_)
+{
+    using namespace qd_detail;
+    const double* _a = qd0_.x;
+    const double* _b = qd1_.x;
+
+    double _q0, _q1, _q2, _q3, _q4, _q5;
+    double _p0 = two_prod(_a[0], _b[0], _q0);
+    double _p1 = two_prod(_a[0], _b[1], _q1);
+    double _p2 = two_prod(_a[1], _b[0], _q2);
+    double _p3 = two_prod(_a[0], _b[2], _q3);
+    double _p4 = two_prod(_a[1], _b[1], _q4);
+    double _p5 = two_prod(_a[2], _b[0], _q5);
+
+    // O(eps) terms
+    three_sum(_p1, _p2, _q0);
+
+    // O(eps^2) terms, six-three sum of (p2, q1, q2) and (p3, p4, p5)
+    three_sum(_p2, _q1, _q2);
+    three_sum(_p3, _p4, _p5);
+
+    double _t0, _t1;
+    double _s0 = two_sum(_p2, _p3, _t0);
+    double _s1 = two_sum(_q1, _p4, _t1);
+    double _s2 = _q2 + _p5;
+    _s1 = two_sum(_s1, _t0, _t0);
+    _s2 += (_t0 + _t1);
+
+    // O(eps^3) terms
+    _s1 += _a[0] * _b[3] + _a[1] * _b[2] + _a[2] * _b[1] + _a[3] * _b[0] + _q0 + _q3 + _q4 + _q5;
+
+    renorm(_p0, _p1, _s0, _s1, _s2);
+    return quadDouble(_p0, _p1, _s0, _s1);
+}
+
+/**
+ * @brief Convert to double, rounded
+ */
+inline double qd_to_double(const quadDouble& qd_)
+{
+    return qd_.x[0] + (qd_.x[1] + (qd_.x[2] + qd_.x[3]));
+}
+
+inline quadDouble operator+(const quadDouble& a_, const quadDouble& b_) { return qd_add(a_, b_); }
+inline quadDouble operator-(const quadDouble& a_, const quadDouble& b_) { return qd_sub(a_, b_); }
+inline quadDouble operator*(const quadDouble& a_, const quadDouble& b_) { return qd_mul(a_, b_); }
@@ -17,6 +17,8 @@ public:
     Shader(const std::filesystem::path& vertex_shader_path, 
             const std::filesystem::path& fragment_shader_path);
 
+    explicit Shader(const std::filesystem::path& compute_shader_path);
+
     ~Shader();
      
     void use_shader();
@@ -32,6 +34,7 @@ public:
 
     void set_vec2(const std::string& name, const glm::vec2& value) const;
     void set_vec2(const std::string& name, float x, float y) const;
+    void set_ivec2(const std::string& name, int x, int y) const;
 
     void set_vec3(const std::string& name, const glm::vec3& value) const;
     void set_vec3(const std::string& name, float x, float y, float z) const;
@@ -42,6 +45,7 @@ public:
 
 private:
     void x_reset();
+    void x_link();
     void x_add_shader( const std::filesystem::path& shader_path, GLenum shader_type);
     auto x_read_shader_file(const std::filesystem::path& file_path)-> std::string;
     
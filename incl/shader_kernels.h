@@ -0,0 +1,34 @@
+#pragma once
+
+#include "perturbation.h"
+
+/**
+ * @brief Uniforms of the mandelbrot shader read by the S, dS and dD kernels.
+ */
+struct Shader_Uniforms_t {
+    float ds_cam_x[2] = { 0.f, 0.f };  ///< u_ds_CameraPosX, (val, err)
+    float ds_cam_y[2] = { 0.f, 0.f };  ///< u_ds_CameraPosY, (val, err)
+    float zoom = 1.f;                  ///< u_CameraZoom, (1 / cameraZoom)
+    float max_iter = 1000.f;           ///< u_MaxIter
+};
+
+/**
+ * @brief Fills the uniforms the same way as main.cpp does.
+ */
+void set_shader_uniforms(
+    double cam_x_,
+    double cam_y_,
+    double zoom_,
+    int max_iter_,
+    Shader_Uniforms_t& rout_u_);
+
+/**
+ * @brief CPU mirrors of render_01_std(), render_01_ds() and render_01_dd().
+ *
+ *  Same arithmetic, in the same order and precision as the shader, for
+ *  measuring the kernels against an exact reference without a GPU.
+ *  (px_, py_) is planePos, in [-1, 1].
+ */
+auto shader_render_01_std(float px_, float py_, const Shader_Uniforms_t& u_)-> Pixel_Result_t;
+auto shader_render_01_ds(float px_, float py_, const Shader_Uniforms_t& u_)-> Pixel_Result_t;
+auto shader_render_01_dd(float px_, float py_, const Shader_Uniforms_t& u_)-> Pixel_Result_t;
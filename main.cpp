@@ -3,6 +3,11 @@
 #include <string>
 #include <format>
 #include <chrono>  
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <vector>
 
 #include <glad/glad.h>
 #include <gl/GL.h> 
@@ -15,12 +20,105 @@
 #include "shader.h"
 #include "incl/fps.h"
 #include "incl/deuxdouble.h"
+#include "perturbation.h"
+#include "bla.h"
+#include "orbit_cache.h"
+#include "julia_atlas.h"
+#include "palette.h"
+#include "headless.h"
 
 // During movement (zoom, translate), for speedy interaction,
 // rendering will be performed  at lower resolution of 
 // (screen_width x screen_height) / SUB_RENDER_FACTOR.
 constexpr int SUB_RENDER_FACTOR = 8;
 
+// Foveated rendering during movement: squares of 1/FOVEA_SIDE of the view,
+// around the crosshair, are rendered again at 1/FOVEA_FACTOR resolution, 
+// each costs 1/256 of a full resolution frame, (the sub-resolution one 1/64).
+constexpr int FOVEA_LEVELS = 3;
+constexpr int FOVEA_FACTOR[FOVEA_LEVELS] = { 4, 2, 1 };
+constexpr int FOVEA_SIDE[FOVEA_LEVELS] = { 4, 8, 16 };
+
+// Temporal upscaling of the sub-resolution frames: the samples are jittered
+// over the SUB_RENDER_FACTOR^2 view pixels of their pixel, (R2 sequence), and
+// accumulated into a full resolution history reprojected with the camera.
+// The idle frame seeds the history with HISTORY_SEED_WEIGHT samples' worth.
+constexpr float HISTORY_SEED_WEIGHT = 16.f;
+
+// Slow movement, up to CHECKER_MAX_SHIFT_PX view pixels per frame, is rendered
+// at 1/CHECKER_FACTOR resolution instead, its jitter cycling over the 2x2 view
+// pixels, (a quarter of the pixels each frame, interleaved), the others are
+// the reprojected history.
+constexpr int CHECKER_FACTOR = 2;
+constexpr double CHECKER_MAX_SHIFT_PX = 4.0;
+
+// Precision of the shader's perturbation deltas (float), for the BLA table radii.
+constexpr double GPU_BLA_EPS = 0x1p-24;
+
+// On-disk reference orbit cache, next to the executable's working directory.
+constexpr const char* ORBIT_CACHE_DIR = "orbit_cache";
+constexpr std::uintmax_t ORBIT_CACHE_BYTES = std::uintmax_t(512) << 20;
+
+// Automatic precision selection:
+// usable bits of the S, dS and dD modes, (magnitude / pixel spacing), measured
+// with 'mandlebrot --precision' at 1500 iterations: up to ~5% of the pixels,
+// in chaotic boundary regions, off by some iterations. The rounding errors grow
+// over the iterations, S and dS keep about half of their 24 and 44-bit mantissa.
+// dD is bound by its double-single camera position, perturbation has no limit.
+constexpr int PRECISION_MODE_BITS[3] = { 12, 30, 48 };
+// a cheaper mode is selected back only once it has this many bits to spare, no flicker at the boundary
+constexpr int PRECISION_HYSTERESIS_BITS = 2;
+
+// In auto mode the view is split into (TILE_GRID x TILE_GRID) tiles, each
+// rendered with the cheapest mode for its own |c|.
+constexpr int TILE_GRID = 8;
+// |z| reaches about |c|, but not much less even around the origin
+constexpr double TILE_MIN_MAGNITUDE = 0.5;
+
+// Julia set atlas, (JULIA_ATLAS_GRID x JULIA_ATLAS_GRID) thumbnails around the crosshair
+constexpr int JULIA_ATLAS_GRID = 8;
+constexpr int JULIA_ATLAS_CELL_PX = 128;
+
+// Supersampling of the idle frames, edge pixels only, one jittered sample
+// per idle frame, (the first is the full resolution render itself).
+// A pixel is an edge if its 3x3 neighbourhood mixes bounded and escaped
+// pixels, or if the variance of the smooth iteration count there is above
+// SSAA_EDGE_VARIANCE, (iterations^2).
+// A pixel is done after SSAA_MIN_SAMPLES, once the standard error of its
+// mean luminance is below SSAA_TOLERANCE, or at SSAA_MAX_SAMPLES, the idle
+// frames stop sampling when all pixels are done.
+constexpr float SSAA_EDGE_VARIANCE = 0.25f;
+constexpr int SSAA_MIN_SAMPLES = 4;
+constexpr int SSAA_MAX_SAMPLES = 64;
+constexpr float SSAA_TOLERANCE = 0.5f / 255.f;
+
+// A window resize is applied to the render textures once no resize event
+// came for RESIZE_SETTLE_SEC, until then the last frame is shown rescaled.
+constexpr double RESIZE_SETTLE_SEC = 0.2;
+
+// Zoom factor of a mouse wheel step
+constexpr double SCROLL_ZOOM_FACTOR = 1.25;
+
+// Keyboard motion is integrated against the frame time, the same at any frame
+// rate: the velocity follows the keys with time constant MOTION_TAU_SEC, and
+// stops below MOTION_STOP, (half-widths or ln(zoom) per second). A frame
+// counts at most MAX_FRAME_DT, the time asleep in glfwWaitEvents() not at all.
+constexpr double MOTION_TAU_SEC = 0.12;
+constexpr double MOTION_STOP = 2e-3;
+constexpr double MAX_FRAME_DT = 0.1;
+
+// Speculative prefetch during keyboard motion: a full resolution frame at the
+// camera predicted PREFETCH_LEAD_SEC ahead, rendered tile by tile, (TILE_GRID
+// x TILE_GRID), and drawn scaled into the view once complete. A motion frame
+// renders as many tiles as fit in what its measured GPU time leaves of
+// PREFETCH_FRAME_BUDGET_SEC, at most PREFETCH_MAX_TILES_PER_FRAME. The frame is
+// started again once the prediction has moved PREFETCH_STALE away from it,
+// (view half-widths, plus ln(zoom)).
+constexpr double PREFETCH_LEAD_SEC = 0.3;
+constexpr double PREFETCH_FRAME_BUDGET_SEC = 0.012;
+constexpr int PREFETCH_MAX_TILES_PER_FRAME = 8;
+constexpr double PREFETCH_STALE = 0.25;
+
 //-----------------------------------------------------------
 // Function prototypes
 void setup_buffers_for_quad_surface( unsigned int& rio_VAO_, unsigned int& rio_VBO_, unsigned int& rio_EBO_);
@@ -36,11 +134,43 @@ void update_mbd_shader_params(
     int  max_iter_,
     int  mode_,
     Input& input_);
+void set_camera_uniforms(const Input::Screen_Camera_t& cam_, bool b_pos_, bool b_zoom_);
 
-void render_mandelbrot();
-void upscale_FBO();
+auto update_reference_orbit(int max_iter_, const Input::Screen_Camera_t& cam_)-> bool;
+void upload_reference_orbit(size_t first_);
+void store_reference_orbit();
+void update_bla_table(const Input::Screen_Camera_t& cam_);
 
-void render_window_title(GLFWwindow* window, float fps_, int max_iter_, int precision_mode_);
+void render_mandelbrot();
+void render_colour_pass(GLuint iter_texture_, int wd_, int ht_, bool b_masked_ = false, bool b_keep_cdf_ = false);
+void colour_julia_atlas(int max_iter_);
+void render_fovea(int mode_);
+auto movement_factor(const Input::Screen_Camera_t& cam_, const Input::Screen_Camera_t& prev_cam_)-> int;
+auto next_taa_jitter(int factor_)-> glm::vec2;
+void render_temporal_upscale(GLuint iter_texture_, int factor_, const Input::Screen_Camera_t& cam_, const glm::vec2& jitter_, int max_iter_);
+void seed_history(const Input::Screen_Camera_t& cam_, int max_iter_);
+void update_colour_params(int max_iter_);
+void update_histogram(GLuint iter_texture_, int wd_, int ht_);
+void upload_palette(int palette_);
+
+void begin_supersampling();
+void render_supersample();
+void resolve_supersampling();
+void composite_view();
+void wait_or_poll_events(bool b_wait_);
+void save_reprojection(const Input::Screen_Camera_t& cam_);
+auto reproject_last_frame(const Input::Screen_Camera_t& cam_)-> bool;
+void update_prefetch(const Input::Screen_Movement_t& mov_, const Input::Screen_Camera_t& cam_, int max_iter_, int mode_);
+auto draw_prefetch(const Input::Screen_Camera_t& cam_, int max_iter_)-> bool;
+void cancel_prefetch();
+auto prefetch_tile_budget()-> int;
+void update_ssaa_active();
+
+auto select_precision_mode(double magnitude_, const floatExp& spacing_, int mode_)-> int;
+auto select_tile_modes(const Input::Screen_Camera_t& cam_, int wd_, int max_mode_)-> int;
+void set_julia_mode(bool b_julia_, const Input::Screen_Camera_t& cam_);
+
+void render_window_title(GLFWwindow* window, float fps_, int max_iter_, int precision_mode_, bool b_auto_mode_, bool b_julia_);
 
 static void window_refresh_callback(GLFWwindow* window);
 static void win_resize_callback(GLFWwindow* window, int w, int h);
@@ -49,16 +179,26 @@ static void mouse_callback(GLFWwindow* window, int button, int action, int mods)
 
 // Function to handle mouse movement events
 static void cursor_pos_callback(GLFWwindow* window, double xpos, double ypos);
+static void scroll_callback(GLFWwindow* window, double xoffset, double yoffset);
 
 void update_camera( 
     bool& rout_b_update_cam,
     bool& rout_b_update_zoom,
+    double dt_,
     Input::Screen_Movement_t& r_mov_,
     Input::Screen_Camera_t& r_cam_);
 
 void create_subres_texture( const int wd_, const int ht_, const int factor_, GLuint& rout_texture_);
+void resize_iter_texture(GLuint texture_, const int wd_, const int ht_);
+void resize_ssaa_textures(const int wd_, const int ht_);
+void resize_view_texture(GLuint texture_, const int wd_, const int ht_);
+void resize_history_textures(const int wd_, const int ht_);
+void resize_render_textures(const int wd_, const int ht_);
+auto texture_bucket(int px_)-> int;
+auto texture_scale(GLuint texture_, int wd_, int ht_)-> glm::vec2;
 
 void double_to_ds(double dval_, float& rout_val_, float& rout_err_);
+void dd_to_ds(const deuxDouble& ddval_, float& rout_val_, float& rout_err_);
 
 //-----------------------------------------------------------
 // Define global variables to track mouse dragging state
@@ -70,12 +210,111 @@ Input g_input; // keyboard input
 
 Shader* gp_mdb_shader = nullptr;
 Shader* gp_hud_shader = nullptr;
-Shader* gp_upscale_shader = nullptr;
+Shader* gp_colour_shader = nullptr;
+Shader* gp_histogram_shader = nullptr;     // compute
+Shader* gp_histogram_cdf_shader = nullptr; // compute
+Shader* gp_ssaa_edge_shader = nullptr;     // compute
+Shader* gp_ssaa_converge_shader = nullptr; // compute
+Shader* gp_ssaa_resolve_shader = nullptr;
+Shader* gp_taa_shader = nullptr;
+
+Julia_Atlas* gp_julia_atlas = nullptr;
 
-int g_scrn_wd{ 1080 };
+int g_scrn_wd{ 1080 }; // render size, the window size once settled
 int g_scrn_ht{ 1080 };
 
-GLuint g_mdb_texture;
+int g_win_wd{ 1080 };  // window size
+int g_win_ht{ 1080 };
+bool g_b_resize_pending = false;
+double g_resize_time{ 0. }; // of the last resize event
+
+GLuint g_mdb_texture;   // iteration buffer, sub-resolution, during movement
+GLuint g_checker_texture; // iteration buffer, 1/CHECKER_FACTOR resolution, during slow movement
+GLuint g_checker_FBO;
+GLuint g_iter_texture;  // iteration buffer, full resolution, idle frames
+GLuint g_iter_FBO;
+
+GLuint g_sample_texture; // iteration buffer, full resolution, a jittered sample of the edge pixels
+GLuint g_sample_FBO;
+GLuint g_edge_mask;      // R8, pixels to supersample
+GLuint g_accum_texture;  // RGBA32F, (sum of the sample colours, number of samples)
+GLuint g_moment_texture; // R32F, sum of the squared sample luminances
+GLuint g_accum_FBO;
+GLuint g_ssaa_active_SSBO; // count of the pixels still sampled, (binding 4)
+int g_ssaa_sample{ 0 };  // samples in the accumulation buffer, 0: to be rendered again
+GLuint g_ssaa_active{ 0 };
+
+// the view image, RGBA8, full resolution, the last rendered frame, (sub-resolution
+// upscaled, or the supersamples resolved), redraws only composite it with the crosshair
+GLuint g_view_texture;
+GLuint g_view_FBO;
+
+// the last full resolution frame, and its camera, shifted into the view while
+// it is panned by whole pixels, (mouse drag), over the sub-resolution render
+GLuint g_reproj_texture;
+GLuint g_reproj_FBO;
+Input::Screen_Camera_t g_reproj_cam;
+bool g_b_reproj = false;
+
+// speculative prefetch, the frame ahead of the keyboard motion
+GLuint g_prefetch_iter;    // iteration buffer, full resolution, filled tile by tile
+GLuint g_prefetch_iter_FBO;
+GLuint g_prefetch_texture; // colours of the last complete frame
+GLuint g_prefetch_FBO;
+Input::Screen_Camera_t g_prefetch_cam;      // of the frame in progress
+Input::Screen_Camera_t g_prefetch_done_cam; // of the complete one
+int g_prefetch_tile{ -1 };  // next tile of the frame in progress, -1: none
+int g_prefetch_max_iter{ 0 };
+bool g_b_prefetch = false;  // g_prefetch_texture holds a complete frame
+
+// GPU time of the motion frames, for the prefetch budget, (two frames in flight)
+GLuint g_motion_query[2];   // the motion frame, without its prefetch tiles
+GLuint g_prefetch_query[2]; // its prefetch tiles
+bool g_b_motion_timed[2]{ false, false };  // g_motion_query holds a result not read yet
+int g_prefetch_timed_tiles[2]{ 0, 0 };     // tiles timed by g_prefetch_query, 0: none
+int g_timer_frame{ 0 };
+double g_motion_sec{ 0. };          // last measured
+double g_prefetch_tile_sec{ 0. };   // last measured, per tile, 0: not yet
+
+// temporal upscaling, the history of the movement frames
+GLuint g_taa_sample_texture; // RGBA8, colours of the jittered samples, (1/CHECKER_FACTOR size)
+GLuint g_taa_sample_FBO;
+GLuint g_history_texture[2]; // RGBA16F, (colour, accumulated weight), the last one and the next
+GLuint g_history_FBO[2];
+int g_history{ 0 };          // index of the last one
+Input::Screen_Camera_t g_history_cam;
+int g_history_max_iter{ 0 };
+float g_history_gain{ 1.f };
+bool g_b_history = false;
+int g_taa_frame{ 0 };
+
+bool g_b_xhair = true;
+bool g_b_atlas = false; // Julia atlas shown instead of the view
+
+GLuint g_palette_texture;
+int g_palette{ 0 };     // [0, N_PALETTES)
+
+// histogram equalisation of the colours
+bool g_b_equalise = false;
+GLuint g_histogram_SSBO;
+GLuint g_cdf_SSBO;
+
+// precision mode of each tile, row by row from the bottom, used in auto mode
+std::array<int, TILE_GRID * TILE_GRID> g_tile_modes{};
+bool g_b_tile_modes = false;
+
+// reference orbit for the perturbation mode, and its shader storage buffer
+Ref_Orbit_t g_ref_orbit;
+GLuint g_orbit_SSBO;
+size_t g_orbit_SSBO_capacity{ 0 }; // in points
+
+// revisited centres load their orbit instead of recomputing it
+Orbit_Cache* gp_orbit_cache = nullptr;
+int g_orbit_stored_iter{ 0 }; // max iteration of the cached copy of g_ref_orbit, 0: none
+
+// BLA table of the reference orbit, and its shader storage buffer
+Bla_Table_t g_bla_table;
+GLuint g_bla_SSBO;
 
 //  buffer indices for quad surface
 unsigned int quadVAO, quadVBO, quadEBO;
@@ -85,8 +324,13 @@ unsigned int crossVAO, crossVBO;
 
 //-----------------------------------------------------------
 using namespace std;
-int main() 
+int main(int argc, char** argv) 
 {
+    if (argc > 1) {
+        // command-line rendering, no window
+        return run_headless(argc, argv);
+    }
+
     // Note: Long Double == Double for MSVC
     cout << "precision info:" << endl;
     cout << " float (min): " << std::numeric_limits<float>::min() << endl;
@@ -130,10 +374,12 @@ int main()
     glfwSetWindowRefreshCallback(window, window_refresh_callback);
     glfwSetWindowSizeCallback(window, win_resize_callback);
     glfwSetWindowAspectRatio(window, 1, 1);
+    glfwGetWindowSize(window, &g_win_wd, &g_win_ht);
  
     glfwSetMouseButtonCallback(window, mouse_callback);
     // Set cursor position callback
     glfwSetCursorPosCallback(window, cursor_pos_callback);
+    glfwSetScrollCallback(window, scroll_callback);
     //-----------------------------------------------------------
 
     setup_buffers_for_quad_surface( quadVAO, quadVBO, quadEBO);
@@ -146,18 +392,28 @@ int main()
     gp_mdb_shader-> use_shader();
 
     gp_mdb_shader-> set_vec3("u_Color", glm::vec3(1.0f, 0.f, 0.f));
-    gp_mdb_shader-> set_float("u_CameraZoom", 1.0 / g_input.m_scrn_cam.cameraZoom);
+    {
+        floatExp _zoom = fe_div(1.0, g_input.m_scrn_cam.cameraZoom);
+        gp_mdb_shader-> set_float("u_CameraZoom", static_cast<float>(fe_to_double(_zoom)));
+        gp_mdb_shader-> set_float("u_fe_CameraZoom.m", static_cast<float>(_zoom.mant));
+        gp_mdb_shader-> set_int("u_fe_CameraZoom.e", _zoom.exp);
+    }
     gp_mdb_shader-> set_float("u_MaxIter", float(_max_iter));
 
     {
         float ds_val, ds_err;
-        double_to_ds(g_input.m_scrn_cam.cameraTranslationX, ds_val, ds_err);
+        dd_to_ds(g_input.m_scrn_cam.cameraTranslationX, ds_val, ds_err);
         gp_mdb_shader->set_vec2("u_ds_CameraPosX", glm::vec2(ds_val, ds_err));
-        double_to_ds(g_input.m_scrn_cam.cameraTranslationY, ds_val, ds_err);
+        dd_to_ds(g_input.m_scrn_cam.cameraTranslationY, ds_val, ds_err);
         gp_mdb_shader->set_vec2("u_ds_CameraPosY", glm::vec2(ds_val, ds_err));
     }
 
 
+    // shader storage buffer for the reference orbit, filled on demand in perturbation mode
+    glGenBuffers(1, &g_orbit_SSBO);
+    gp_orbit_cache = new Orbit_Cache(ORBIT_CACHE_DIR, ORBIT_CACHE_BYTES);
+    glGenBuffers(1, &g_bla_SSBO);
+
     // create sub-resolution texture for rendering
     create_subres_texture( g_scrn_wd, g_scrn_ht, SUB_RENDER_FACTOR, g_mdb_texture);
 
@@ -165,6 +421,106 @@ int main()
     unsigned int mandelbrotFBO;
     setup_FBO(g_mdb_texture, mandelbrotFBO);
 
+    create_subres_texture( g_scrn_wd, g_scrn_ht, CHECKER_FACTOR, g_checker_texture);
+    setup_FBO(g_checker_texture, g_checker_FBO);
+
+    // full resolution, for the idle frames
+    create_subres_texture( g_scrn_wd, g_scrn_ht, 1, g_iter_texture);
+    setup_FBO(g_iter_texture, g_iter_FBO);
+
+    // palette of the colouring pass
+    glGenTextures(1, &g_palette_texture);
+    upload_palette(g_palette);
+
+    gp_colour_shader->use_shader();
+    gp_colour_shader->set_int("u_IterTexture", 0);
+    gp_colour_shader->set_int("u_Palette", 1);
+    gp_colour_shader->set_int("u_SampleMask", 2);
+    update_colour_params(_max_iter);
+
+    // supersampling of the idle frames
+    create_subres_texture( g_scrn_wd, g_scrn_ht, 1, g_sample_texture);
+    setup_FBO(g_sample_texture, g_sample_FBO);
+
+    glGenTextures(1, &g_edge_mask);
+    glGenTextures(1, &g_accum_texture);
+    glGenTextures(1, &g_moment_texture);
+    resize_ssaa_textures(texture_bucket(g_scrn_wd), texture_bucket(g_scrn_ht));
+    setup_FBO(g_accum_texture, g_accum_FBO);
+    {
+        // the colouring pass writes the squared luminance to the second attachment
+        glBindFramebuffer(GL_FRAMEBUFFER, g_accum_FBO);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, g_moment_texture, 0);
+        const GLenum _draw_buffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+        glDrawBuffers(2, _draw_buffers);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    glGenBuffers(1, &g_ssaa_active_SSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_ssaa_active_SSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(GLuint), nullptr, GL_DYNAMIC_READ);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, g_ssaa_active_SSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    gp_mdb_shader->use_shader();
+    gp_mdb_shader->set_int("u_SampleMask", 2);
+
+    gp_ssaa_edge_shader->use_shader();
+    gp_ssaa_edge_shader->set_float("u_EdgeVariance", SSAA_EDGE_VARIANCE);
+
+    gp_ssaa_converge_shader->use_shader();
+    gp_ssaa_converge_shader->set_float("u_MinSamples", float(SSAA_MIN_SAMPLES));
+    gp_ssaa_converge_shader->set_float("u_Tolerance", SSAA_TOLERANCE);
+
+    gp_ssaa_resolve_shader->use_shader();
+    gp_ssaa_resolve_shader->set_int("u_AccumTexture", 0);
+
+    // the view image
+    glGenTextures(1, &g_view_texture);
+    resize_view_texture(g_view_texture, texture_bucket(g_scrn_wd), texture_bucket(g_scrn_ht));
+    setup_FBO(g_view_texture, g_view_FBO);
+
+    glGenTextures(1, &g_reproj_texture);
+    resize_view_texture(g_reproj_texture, texture_bucket(g_scrn_wd), texture_bucket(g_scrn_ht));
+    setup_FBO(g_reproj_texture, g_reproj_FBO);
+
+    create_subres_texture( g_scrn_wd, g_scrn_ht, 1, g_prefetch_iter);
+    setup_FBO(g_prefetch_iter, g_prefetch_iter_FBO);
+    glGenTextures(1, &g_prefetch_texture);
+    resize_view_texture(g_prefetch_texture, texture_bucket(g_scrn_wd), texture_bucket(g_scrn_ht));
+    setup_FBO(g_prefetch_texture, g_prefetch_FBO);
+    glGenQueries(2, g_motion_query);
+    glGenQueries(2, g_prefetch_query);
+
+    // temporal upscaling
+    glGenTextures(1, &g_taa_sample_texture);
+    resize_view_texture(g_taa_sample_texture,
+        texture_bucket(g_scrn_wd / CHECKER_FACTOR),
+        texture_bucket(g_scrn_ht / CHECKER_FACTOR));
+    setup_FBO(g_taa_sample_texture, g_taa_sample_FBO);
+
+    glGenTextures(2, g_history_texture);
+    resize_history_textures(texture_bucket(g_scrn_wd), texture_bucket(g_scrn_ht));
+    setup_FBO(g_history_texture[0], g_history_FBO[0]);
+    setup_FBO(g_history_texture[1], g_history_FBO[1]);
+
+    gp_taa_shader->use_shader();
+    gp_taa_shader->set_int("u_Samples", 0);
+    gp_taa_shader->set_int("u_Prior", 1);
+    gp_taa_shader->set_int("u_History", 2);
+
+    // histogram and its CDF, (bindings 2 and 3 of the compute and colour shaders)
+    glGenBuffers(1, &g_histogram_SSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_histogram_SSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, HISTOGRAM_BINS * sizeof(GLuint), nullptr, GL_DYNAMIC_COPY);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, g_histogram_SSBO);
+
+    glGenBuffers(1, &g_cdf_SSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_cdf_SSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, HISTOGRAM_BINS * sizeof(GLfloat), nullptr, GL_DYNAMIC_COPY);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, g_cdf_SSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
 
     //-----------------------------------------------------------
     
@@ -174,42 +530,186 @@ int main()
 
     glfwSwapInterval(1); //  1: turn on v-sync, 0: off
     
-    int _mode = 1; // default using 'dS' precision
+    int _mode = 1;
+    bool _b_auto_mode = true; // default, precision selected by the zoom depth
     bool _b_idle = true;
 
+    // Julia mode, the Mandelbrot view is kept to return to
+    bool _b_julia = false;
+    Input::Screen_Camera_t _mdb_cam;
+    int _mdb_mode = 0; // precision mode of the Mandelbrot view, restored on return from Julia mode
+
+    // camera and max iteration of the full resolution frame
+    Input::Screen_Camera_t _idle_cam;
+    int _idle_iter = _max_iter;
+
     FPSCounter* _FPS = FPSCounter::getInstance();
     _FPS->start();
 
     // main event loop --->
-    bool b_xhair = true;
+    bool _b_xhair_shown = g_b_xhair;
+    int _win_wd_shown = g_win_wd;
+    int _win_ht_shown = g_win_ht;
+    double _t_prev = glfwGetTime();
+    bool _b_atlas_shown = false;
     while (!glfwWindowShouldClose(window)) {
 
         bool b_update_cam{ false };
         bool b_update_zoom{ false };
         bool b_update_mode{ false }; 
+        bool b_toggle_julia{ false };
+        bool b_update_palette{ false };
+        bool b_toggle_equalise{ false };
+
+        g_input.handle(_max_iter, b_update_mode, g_b_xhair, b_toggle_julia, g_b_atlas, b_update_palette, b_toggle_equalise);
 
-        g_input.handle(_max_iter, b_update_mode, b_xhair);
+        // crosshair on/off, only the view image is drawn again
+        bool b_toggle_xhair = (g_b_xhair != _b_xhair_shown);
+        _b_xhair_shown = g_b_xhair;
+
+        // window resized, the view image is shown rescaled until the size settles,
+        // then rendered at the new size
+        bool b_rescale = (g_win_wd != _win_wd_shown || g_win_ht != _win_ht_shown);
+        _win_wd_shown = g_win_wd;
+        _win_ht_shown = g_win_ht;
+
+        if (g_b_resize_pending && glfwGetTime() - g_resize_time >= RESIZE_SETTLE_SEC) {
+            resize_render_textures(g_win_wd, g_win_ht);
+            g_b_resize_pending = false;
+        }
+
+        // nothing changed and no progressive work left, sleep until the next event
+        bool b_wait{ false };
+
+        // next palette, only the colouring pass is run again,
+        // the prefetch frame is in the old colours
+        if (b_update_palette) {
+            g_palette = (g_palette + 1) % N_PALETTES;
+            upload_palette(g_palette);
+            cancel_prefetch();
+        }
+
+        // histogram equalisation on/off, again only the colouring pass
+        if (b_toggle_equalise) {
+            g_b_equalise = !g_b_equalise;
+            b_update_palette = true;
+            cancel_prefetch();
+        }
 
-        // toggle the rendering precision ( single-> double-single-> double double) 
+        // toggle the rendering precision ( auto-> single-> double-single-> double double-> perturbation-> auto) 
+        // there is no perturbation for Julia sets, double double is the last there
         if (b_update_mode) {
-            _mode = (_mode + 1) % 3;
+            if (_b_auto_mode) {
+                _b_auto_mode = false;
+                _mode = 0;
+            } else if (_mode == 3 || (_b_julia && _mode == 2)) {
+                _b_auto_mode = true;
+            } else {
+                _mode = _mode + 1;
+            }
             b_update_mode = false;
         }
 
-       
+        // camera of the last frame
+        Input::Screen_Camera_t _prev_cam = g_input.m_scrn_cam;
 
-        double _fps = _FPS->update();
-        render_window_title(window, _fps, _max_iter, _mode);
+        // frame time, from the wake up after a sleep, (the key that woke the loop moves the camera)
+        double _t_frame = glfwGetTime();
+        double _dt = std::min(_t_frame - _t_prev, MAX_FRAME_DT);
+        _t_prev = _t_frame;
 
         update_camera( 
             b_update_cam,
             b_update_zoom,
+            _dt,
             g_input.m_scrn_mov,
             g_input.m_scrn_cam);
 
+        // toggle Julia mode, the crosshair position becomes the Julia constant
+        if (b_toggle_julia) {
+            _b_julia = !_b_julia;
+            gp_mdb_shader->use_shader();
+            set_julia_mode(_b_julia, g_input.m_scrn_cam);
+
+            if (_b_julia) {
+                _mdb_cam = g_input.m_scrn_cam;
+                g_input.m_scrn_cam = {};
+                g_input.m_scrn_cam.cameraTranslationX = 0.;
+                g_input.m_scrn_cam.cameraTranslationY = 0.;
+                _mdb_mode = _mode;
+                _mode = std::min(_mode, 2);
+            } else {
+                g_input.m_scrn_cam = _mdb_cam;
+                _mode = _mdb_mode;
+            }
+            b_update_cam = true;
+            b_update_zoom = true;
+            b_update_mode = true;
+        }
+
+        if (_b_auto_mode) {
+            // the frame mode is the highest of the tiles, (sets up the perturbation orbit if needed)
+            int _auto_mode = select_tile_modes(g_input.m_scrn_cam, g_scrn_wd, _b_julia ? 2 : 3);
+            if (_auto_mode != _mode) {
+                _mode = _auto_mode;
+                b_update_mode = true;
+            }
+        }
+        g_b_tile_modes = _b_auto_mode;
+
+        double _fps = _FPS->update();
+        render_window_title(window, _fps, _max_iter, _mode, _b_auto_mode, _b_julia);
+
+        if (g_b_atlas) {
+            // Julia sets around the crosshair of the Mandelbrot view, only the new ones are rendered
+            const Input::Screen_Camera_t& _cam = _b_julia ? _mdb_cam : g_input.m_scrn_cam;
+            int _n_new = gp_julia_atlas->update(
+                _cam.cameraTranslationX.val,
+                _cam.cameraTranslationY.val,
+                fe_to_double(fe_div(4.0, _cam.cameraZoom)),
+                _max_iter);
+
+            // coloured as the view, again for a palette or equalisation changed since
+            if (_n_new > 0 || b_update_palette || !_b_atlas_shown) {
+                colour_julia_atlas(_max_iter);
+            }
+
+            b_wait = !(_n_new > 0 || b_update_palette || !_b_atlas_shown || b_toggle_xhair || b_rescale || b_update_cam || b_update_zoom);
+            if (!b_wait) {
+                composite_view();
+                glfwSwapBuffers(window);
+                _b_atlas_shown = true;
+            }
+
+            // the view is rendered again on return
+            _b_idle = false;
+
+            wait_or_poll_events(b_wait);
+            if (b_wait) {
+                _t_prev = glfwGetTime();
+            }
+            continue;
+        }
+        _b_atlas_shown = false;
+
         if (b_update_cam || b_update_zoom || b_update_mode) {
             // there is camera motion, view is being changed and we need to recalculate the Mandelbrot
 
+            // the last full resolution frame is kept, for the pans that follow
+            if (_b_idle) {
+                save_reprojection(_idle_cam);
+                seed_history(_idle_cam, _idle_iter);
+            }
+            if (b_update_zoom || b_update_mode || b_update_palette || b_toggle_equalise || _max_iter != _idle_iter) {
+                g_b_reproj = false;
+            }
+            if (b_update_mode) {
+                cancel_prefetch();
+            }
+            if (b_update_mode || b_update_palette || b_toggle_equalise) {
+                g_b_history = false;
+            }
+
             //printf("[active] zoom:%.4e, fps:%.1f, iteration: %d, mode: %d\n", g_input.m_scrn_cam.cameraZoom, _fps, _max_iter, _mode);
 
             gp_mdb_shader->use_shader();
@@ -217,59 +717,103 @@ int main()
             update_mbd_shader_params(
                 b_update_cam, b_update_zoom, b_update_mode,
                 _max_iter, _mode, g_input);
+            update_colour_params(_max_iter);
              
+            // slow movement interleaved at 1/CHECKER_FACTOR, else sub-resolution
+            int _factor = movement_factor(g_input.m_scrn_cam, _prev_cam);
+            GLuint _texture = (_factor == CHECKER_FACTOR) ? g_checker_texture : g_mdb_texture;
+
+            // GPU time of the frame, the prefetch tiles get what it leaves of their budget
+            glBeginQuery(GL_TIME_ELAPSED, g_motion_query[g_timer_frame]);
+
             // Bind the framebuffer object (FBO) to render to
-            glBindFramebuffer(GL_FRAMEBUFFER, mandelbrotFBO);
-            glViewport(0, 0, g_scrn_wd / SUB_RENDER_FACTOR, g_scrn_ht / SUB_RENDER_FACTOR);
-            
+            glBindFramebuffer(GL_FRAMEBUFFER, (_factor == CHECKER_FACTOR) ? g_checker_FBO : mandelbrotFBO);
+            glViewport(0, 0, g_scrn_wd / _factor, g_scrn_ht / _factor);
+
+            // at another sub-pixel position each frame, for the temporal upscaling
+            glm::vec2 _jitter = next_taa_jitter(_factor);
+            gp_mdb_shader->set_vec2("u_Jitter", glm::vec2(
+                2.f * _jitter.x * _factor / g_scrn_wd,
+                2.f * _jitter.y * _factor / g_scrn_ht));
+
             render_mandelbrot();
+
+            gp_mdb_shader->use_shader();
+            gp_mdb_shader->set_vec2("u_Jitter", glm::vec2(0.f, 0.f));
   
-            // Unbind the framebuffer to render to the default framebuffer
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
-            glViewport(0, 0, g_scrn_wd, g_scrn_ht);
+            // upscaled colours, blended into the history, into the view image
+            render_temporal_upscale(_texture, _factor, g_input.m_scrn_cam, _jitter, _max_iter);
 
-            upscale_FBO();
-            if (b_xhair) {
-                render_crosshair();
+            // full resolution where the prefetched frame covers the view, under the fovea
+            draw_prefetch(g_input.m_scrn_cam, _max_iter);
+
+            // finer around the crosshair, (no coarser than the interleaved frame)
+            if (_factor == SUB_RENDER_FACTOR) {
+                render_fovea(_mode);
             }
-            glfwSwapBuffers(window);
+
+            // full resolution where the last idle frame covers the view
+            if (g_b_reproj) {
+                reproject_last_frame(g_input.m_scrn_cam);
+            }
+
+            glEndQuery(GL_TIME_ELAPSED);
+            g_b_motion_timed[g_timer_frame] = true;
+
+            // the tiles of the frame ahead of the motion the frame has time for
+            update_prefetch(g_input.m_scrn_mov, g_input.m_scrn_cam, _max_iter, _mode);
+            g_timer_frame ^= 1;
 
             _b_idle = false;
         }
-        else {
+        else if (!_b_idle || g_ssaa_sample == 0) {
+            // full resolution iteration buffer
+            glBindFramebuffer(GL_FRAMEBUFFER, g_iter_FBO);
+            glViewport(0, 0, g_scrn_wd, g_scrn_ht);
 
-            if (!_b_idle) {
-                // Unbind the framebuffer to render to the default framebuffer
-                glBindFramebuffer(GL_FRAMEBUFFER, 0);
-                glViewport(0, 0, g_scrn_wd, g_scrn_ht);
+            render_mandelbrot();
 
-                render_mandelbrot();
-                if (b_xhair) {
-                    render_crosshair();
-                }
+            // Unbind the framebuffer to render to the default framebuffer
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+            // the view has settled, its orbit is worth caching
+            store_reference_orbit();
+
+            // first sample of the supersampling, and its edge pixels
+            begin_supersampling();
+            resolve_supersampling();
        
-                _b_idle = true;
-            }
-            else {
-                // copy the front buffer to back
-                GLint _viewport[4];
-                glGetIntegerv(GL_VIEWPORT, _viewport);
-
-                glReadBuffer(GL_FRONT);
-                glDrawBuffer(GL_BACK);
-
-                glBlitFramebuffer(
-                    _viewport[0], _viewport[1], _viewport[2], _viewport[3],
-                    _viewport[0], _viewport[1], _viewport[2], _viewport[3],
-                    GL_COLOR_BUFFER_BIT,
-                    GL_NEAREST);
-            }
+            _b_idle = true;
+            _idle_cam = g_input.m_scrn_cam;
+            _idle_iter = _max_iter;
+        }
+        else if (b_update_palette) {
+            // colour the same iterations again, the supersampling starts over
+            begin_supersampling();
+            resolve_supersampling();
+        }
+        else if (g_ssaa_active > 0 && g_ssaa_sample < SSAA_MAX_SAMPLES) {
+            // one more sample of the edge pixels not converged yet
+            render_supersample();
+            resolve_supersampling();
+        }
+        else if (!b_toggle_xhair && !b_rescale) {
+            // the image on screen is final, nothing to present
+            b_wait = true;
+        }
 
+        if (!b_wait) {
+            // the view image, crosshair on top
+            composite_view();
             glfwSwapBuffers(window);
-
         }
 
-        glfwPollEvents();
+        wait_or_poll_events(b_wait);
+
+        // the time asleep is not frame time
+        if (b_wait) {
+            _t_prev = glfwGetTime();
+        }
 
     } // <--- main event loop
 
@@ -280,6 +824,47 @@ int main()
     glDeleteVertexArrays(1, &crossVAO);
     glDeleteBuffers(1, &crossVBO);
 
+    glDeleteBuffers(1, &g_orbit_SSBO);
+    glDeleteBuffers(1, &g_bla_SSBO);
+
+    glDeleteBuffers(1, &g_histogram_SSBO);
+    glDeleteBuffers(1, &g_cdf_SSBO);
+
+    glDeleteFramebuffers(1, &g_iter_FBO);
+    glDeleteTextures(1, &g_iter_texture);
+
+    glDeleteFramebuffers(1, &g_sample_FBO);
+    glDeleteFramebuffers(1, &g_accum_FBO);
+    glDeleteTextures(1, &g_sample_texture);
+    glDeleteTextures(1, &g_edge_mask);
+    glDeleteTextures(1, &g_accum_texture);
+    glDeleteTextures(1, &g_moment_texture);
+
+    glDeleteFramebuffers(1, &g_view_FBO);
+    glDeleteTextures(1, &g_view_texture);
+    glDeleteFramebuffers(1, &g_reproj_FBO);
+    glDeleteTextures(1, &g_reproj_texture);
+    glDeleteFramebuffers(1, &g_prefetch_iter_FBO);
+    glDeleteTextures(1, &g_prefetch_iter);
+    glDeleteFramebuffers(1, &g_prefetch_FBO);
+    glDeleteTextures(1, &g_prefetch_texture);
+    glDeleteQueries(2, g_motion_query);
+    glDeleteQueries(2, g_prefetch_query);
+    glDeleteFramebuffers(1, &g_checker_FBO);
+    glDeleteTextures(1, &g_checker_texture);
+    glDeleteFramebuffers(1, &g_taa_sample_FBO);
+    glDeleteTextures(1, &g_taa_sample_texture);
+    glDeleteFramebuffers(2, g_history_FBO);
+    glDeleteTextures(2, g_history_texture);
+    glDeleteBuffers(1, &g_ssaa_active_SSBO);
+    glDeleteTextures(1, &g_palette_texture);
+
+    delete gp_orbit_cache;
+    gp_orbit_cache = nullptr;
+
+    delete gp_julia_atlas;
+    gp_julia_atlas = nullptr;
+
     glfwTerminate();
     return 0;
 }
@@ -403,7 +988,10 @@ void setup_FBO(const GLuint texture_, unsigned int& rio_FBO_)
 /**
  * @brief Initialize our shaders
  *
- * 3 shaders: mandelbrot renderer, upscaler, and crosshair plotter
+ * 3 shaders: mandelbrot renderer, colouring pass (and upscaler), and crosshair plotter,
+ * 4 compute shaders: iteration histogram and its CDF, edge mask and convergence of the supersampling,
+ * the resolve of the supersampling,
+ * and the Julia atlas with its own
  * 
  */
 void init_shaders( )
@@ -417,9 +1005,24 @@ void init_shaders( )
             "shaders/hud_shader.vs.glsl",
             "shaders/hud_shader.fs.glsl");
 
-        gp_upscale_shader = new Shader(
+        gp_colour_shader = new Shader(
+            "shaders/upscale_shader.vs.glsl",
+            "shaders/colour_shader.fs.glsl");
+
+        gp_histogram_shader = new Shader("shaders/histogram.comp.glsl");
+        gp_histogram_cdf_shader = new Shader("shaders/histogram_cdf.comp.glsl");
+
+        gp_ssaa_edge_shader = new Shader("shaders/ssaa_edge.comp.glsl");
+        gp_ssaa_converge_shader = new Shader("shaders/ssaa_converge.comp.glsl");
+        gp_ssaa_resolve_shader = new Shader(
+            "shaders/upscale_shader.vs.glsl",
+            "shaders/ssaa_resolve.fs.glsl");
+
+        gp_taa_shader = new Shader(
             "shaders/upscale_shader.vs.glsl",
-            "shaders/upscale_shader.fs.glsl");
+            "shaders/taa_resolve.fs.glsl");
+
+        gp_julia_atlas = new Julia_Atlas(JULIA_ATLAS_GRID, JULIA_ATLAS_CELL_PX);
     }
     catch (const std::runtime_error& e) {
         // Handle the exception
@@ -460,239 +1063,1396 @@ void update_mbd_shader_params(
     gp_mdb_shader->set_float("u_MaxIter", float(max_iter_));
     gp_mdb_shader->set_int("u_Mode", mode_);
 
-    if (b_update_cam) {
-        float ds_val, ds_err;
+    set_camera_uniforms(input_.m_scrn_cam, b_update_cam, b_update_zoom);
+
+    if (mode_ == 3) {
+        bool _b_new_orbit = update_reference_orbit(max_iter_, input_.m_scrn_cam);
+
+        // BLA radii depend on the view size as well
+        if (_b_new_orbit || b_update_zoom || b_update_mode) {
+            update_bla_table(input_.m_scrn_cam);
+        }
+    }
+    return;
+}
 
-        double_to_ds(input_.m_scrn_cam.cameraTranslationX, ds_val, ds_err);
-        //printf("[CAM] PX: %.20lf =  %.20f, %.20f\n", input_.m_scrn_cam.cameraTranslationX, ds_val, ds_err);
+/**
+ * @brief Camera uniforms of the Mandelbrot shader, (in use).
+ *
+ * @param[in] cam_, camera state
+ * @param[in] b_pos_, set the camera position
+ * @param[in] b_zoom_, set the zoom
+ */
+void set_camera_uniforms(const Input::Screen_Camera_t& cam_, bool b_pos_, bool b_zoom_)
+{
+    if (b_pos_) {
+        float ds_val, ds_err;
 
+        dd_to_ds(cam_.cameraTranslationX, ds_val, ds_err);
         gp_mdb_shader->set_vec2("u_ds_CameraPosX", glm::vec2(ds_val, ds_err));
 
-        double_to_ds(input_.m_scrn_cam.cameraTranslationY, ds_val, ds_err);
+        dd_to_ds(cam_.cameraTranslationY, ds_val, ds_err);
         gp_mdb_shader->set_vec2("u_ds_CameraPosY", glm::vec2(ds_val, ds_err));
     }
 
-    if (b_update_zoom) {
-        double _zoom = 1.0 / input_.m_scrn_cam.cameraZoom;
-        gp_mdb_shader->set_float("u_CameraZoom", static_cast<float>(_zoom));
+    if (b_zoom_) {
+        floatExp _zoom = fe_div(1.0, cam_.cameraZoom);
+        gp_mdb_shader->set_float("u_CameraZoom", static_cast<float>(fe_to_double(_zoom)));
+
+        // float mantissa + int exponent, for the perturbation mode
+        gp_mdb_shader->set_float("u_fe_CameraZoom.m", static_cast<float>(_zoom.mant));
+        gp_mdb_shader->set_int("u_fe_CameraZoom.e", _zoom.exp);
     }
     return;
 }
 
 /**
- * @brief
+ * @brief Store the reference orbit in the orbit cache, once the view has
+ * settled, (idle frame), if it is not there yet.
+ *
+ * The file is written and the cache evicted on the render thread, never
+ * for the orbits of the motion frames.
  */
-void render_mandelbrot()
+void store_reference_orbit()
 {
-    gp_mdb_shader->use_shader();
-
-    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    glBindVertexArray(quadVAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    if (g_ref_orbit.points.empty() || g_orbit_stored_iter == g_ref_orbit.max_iter) {
+        return;
+    }
 
+    gp_orbit_cache->store(g_ref_orbit);
+    g_orbit_stored_iter = g_ref_orbit.max_iter;
     return;
 }
 
 /**
- * @brief
+ * @brief Switch the shader between the Mandelbrot and the Julia set, uniforms only, 
+ * no recompile.
+ *
+ * @param[in] b_julia_, true for the Julia set
+ * @param[in] cam_, camera state, its position is the Julia constant
  */
-void upscale_FBO()
+void set_julia_mode(bool b_julia_, const Input::Screen_Camera_t& cam_)
 {
-    gp_upscale_shader->use_shader();
+    gp_mdb_shader->set_int("u_MandelbrotMode", b_julia_ ? 0 : 1);
 
-    glBindTexture(GL_TEXTURE_2D, g_mdb_texture); // Bind Mandelbrot texture to read from
-    glBindVertexArray(quadVAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    if (b_julia_) {
+        float ds_val, ds_err;
+
+        dd_to_ds(cam_.cameraTranslationX, ds_val, ds_err);
+        gp_mdb_shader->set_vec2("u_ds_JuliaX", glm::vec2(ds_val, ds_err));
 
+        dd_to_ds(cam_.cameraTranslationY, ds_val, ds_err);
+        gp_mdb_shader->set_vec2("u_ds_JuliaY", glm::vec2(ds_val, ds_err));
+    }
     return;
 }
 
 /**
- * @brief Update the windows title bar with status info.
+ * @brief Recompute the reference orbit at the camera position (or load it from
+ * the orbit cache), and upload it.
  *
- * @param[in] *window_, pointer to window object
- * @param[in] fps_, frame-rate
- * @param[in] max_iter_, current max iteration set 
- * @param[in] precision_mode_, current rendering precision mode [0,1] 
+ * Only when the camera position has changed since the last upload, zooming
+ * alone keeps the orbit. A higher max iteration extends the orbit instead,
+ * and only the new points are uploaded, a lower one keeps it as it is.
+ * A new orbit is not stored in the cache here, the motion frames would fill
+ * it with one-off orbits, (see store_reference_orbit()).
+ *
+ * @param[in] max_iter_, current max iteration
+ * @param[in] cam_, camera state
+ * @return true if the orbit has changed
  */
-void render_window_title(GLFWwindow* window_, float fps_, int max_iter_, int precision_mode_ )
+auto update_reference_orbit(int max_iter_, const Input::Screen_Camera_t& cam_)-> bool
 {
-    //std::string msStr = std::to_string((timeDiff / counter) * 1000);
-    std::string newTitle = 
-        ( std::format("{:.1f}", fps_) 
-            + "fps, max:"
-            + std::format("{}", max_iter_) );
+    const deuxDouble& _cx = cam_.cameraTranslationX;
+    const deuxDouble& _cy = cam_.cameraTranslationY;
 
-    if (precision_mode_ == 0) {
-        newTitle += ", S";
-    } else if (precision_mode_ == 1) {
-        newTitle += ", dS";
-    } else if (precision_mode_ == 2) {
-        newTitle += ", dD";
-    }
+    if (!g_ref_orbit.points.empty()
+        && g_ref_orbit.cx.val == _cx.val && g_ref_orbit.cx.err == _cx.err
+        && g_ref_orbit.cy.val == _cy.val && g_ref_orbit.cy.err == _cy.err) {
 
-    glfwSetWindowTitle(window_, newTitle.c_str());
+        if (max_iter_ <= g_ref_orbit.max_iter) {
+            return false;
+        }
 
-    return;
+        size_t _n_old = g_ref_orbit.points.size();
+        extend_reference_orbit(max_iter_, g_ref_orbit);
+
+        if (g_ref_orbit.points.size() == _n_old) {
+            // escaped orbit, nothing new
+            return false;
+        }
+
+        upload_reference_orbit(_n_old);
+        return true;
+    }
+
+    if (gp_orbit_cache->load(_cx, _cy, max_iter_, g_ref_orbit)) {
+        g_orbit_stored_iter = g_ref_orbit.max_iter;
+    }
+    else {
+        compute_reference_orbit(_cx, _cy, max_iter_, g_ref_orbit);
+        g_orbit_stored_iter = 0;
+    }
 
+    upload_reference_orbit(0);
+    return true;
 }
 
 /**
- * @brief Callback function for window refresh event
+ * @brief Upload the reference orbit, from point first_ on.
+ *
+ * The points before first_ are already in the buffer. The buffer grows to
+ * the next power of two, so that most extensions are uploaded in place,
+ * when it has to be reallocated, the old points are copied on the GPU.
+ *
+ * @param[in] first_, first point to upload, 0 for the whole orbit
  */
-static void window_refresh_callback( GLFWwindow* window)
+void upload_reference_orbit(size_t first_)
 {
-    glClearColor(0.2f, 0.0f, 0.2f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    const size_t _n = g_ref_orbit.points.size();
+    const size_t _pt = sizeof(Orbit_Point_t);
 
-    gp_mdb_shader->use_shader(); 
-    glBindVertexArray(quadVAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    if (_n > g_orbit_SSBO_capacity) {
+        size_t _capacity = std::bit_ceil(_n);
 
-    {
-        // Render Crosshair
-        gp_hud_shader->use_shader(); 
-        glBindVertexArray(crossVAO);
-        glLineWidth(3.0f);
-        glDrawArrays(GL_LINES, 0, 4);
+        if (first_ == 0) {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_orbit_SSBO);
+            glBufferData(GL_SHADER_STORAGE_BUFFER, _capacity * _pt, nullptr, GL_DYNAMIC_DRAW);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+        }
+        else {
+            GLuint _ssbo;
+            glGenBuffers(1, &_ssbo);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, _ssbo);
+            glBufferData(GL_COPY_WRITE_BUFFER, _capacity * _pt, nullptr, GL_DYNAMIC_DRAW);
+
+            glBindBuffer(GL_COPY_READ_BUFFER, g_orbit_SSBO);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, first_ * _pt);
+
+            glBindBuffer(GL_COPY_READ_BUFFER, 0);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+            glDeleteBuffers(1, &g_orbit_SSBO);
+            g_orbit_SSBO = _ssbo;
+        }
+        g_orbit_SSBO_capacity = _capacity;
     }
-    glBindVertexArray(0);
-    glfwSwapBuffers(window);
 
-    // important, this waits until rendering result is actually visible, 
-    // thus making resizing less ugly
-    glFinish(); 
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_orbit_SSBO);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER,
+        first_ * _pt,
+        (_n - first_) * _pt,
+        g_ref_orbit.points.data() + first_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, g_orbit_SSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    gp_mdb_shader->set_int("u_RefOrbitLen", static_cast<int>(_n));
+    return;
 }
 
 /**
- * @brief Callback function for window size change event
+ * @brief Rebuild the BLA table of the reference orbit for the current view, and upload it.
+ *
+ * @param[in] cam_, camera state
  */
-static void win_resize_callback(GLFWwindow* window, int w, int h)
-{ 
-    g_scrn_wd = w;
-    g_scrn_ht = h;
+void update_bla_table(const Input::Screen_Camera_t& cam_)
+{
+    // largest |dc| on screen, the corner of the view, (2 / cameraZoom) * sqrt(2)
+    double _dc_max = fe_to_double(fe_div(2.0 * std::sqrt(2.0), cam_.cameraZoom));
 
-    glViewport(0, 0, w, h);
+    build_bla_table(g_ref_orbit, _dc_max, GPU_BLA_EPS, g_bla_table);
 
-    //-- resize the mandelbrot quarter-texture object too.
-    glBindTexture(GL_TEXTURE_2D, g_mdb_texture);
-    glTexImage2D(
-        GL_TEXTURE_2D, 0, GL_RGBA,
-        g_scrn_wd / SUB_RENDER_FACTOR,
-        g_scrn_ht / SUB_RENDER_FACTOR,
-        0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    std::vector<Bla_Gpu_Step_t> _gpu_steps;
+    bla_to_gpu(g_bla_table, _gpu_steps);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_bla_SSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER,
+        _gpu_steps.size() * sizeof(Bla_Gpu_Step_t),
+        _gpu_steps.data(),
+        GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, g_bla_SSBO);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 
-    // Future: Maintain 1:1 pixel-aspect ratio for non 1:1 window-aspect ratio
-    //if (w > h) {
-    //   glViewport(0, (h - w) / 2, w, w);
-    //}
-    //else {
-    //    glViewport((w - h) / 2, 0, h, h);
-    //}
+    // the shader holds at most 32 levels, enough for orbits of 2^32 points
+    int _levels = std::min(static_cast<int>(g_bla_table.level_count.size()), 32);
+    gp_mdb_shader->set_int("u_BlaLevels", _levels);
+
+    for (int _l = 0; _l < _levels; ++_l) {
+        gp_mdb_shader->set_int(std::format("u_BlaOffset[{}]", _l), g_bla_table.level_offset[_l]);
+        gp_mdb_shader->set_int(std::format("u_BlaCount[{}]", _l), g_bla_table.level_count[_l]);
+    }
     return;
 }
 
-
 /**
- * @brief  Callback function for key events
+ * @brief
  */
-static void key_callback(GLFWwindow* win, int key, int scancode, int action, int mods)
+void render_mandelbrot()
 {
-    // Handle key events using Input class
-    Input* input = (Input*)glfwGetWindowUserPointer(win);
-    input->check_keys(win, key, scancode, action, mods);
-    return;
-}
+    gp_mdb_shader->use_shader();
 
-// Function to update camera parameters based on frame rate and user input
-void update_camera(
-    bool& rout_b_update_cam,
-    bool& rout_b_update_zoom,
-    Input::Screen_Movement_t& r_mov_,
-    Input::Screen_Camera_t& r_cam_)
-{
-    if (r_mov_.reset_view) {
-        r_cam_ = {}; // Use designated initializer to reset to default values
-        rout_b_update_cam  = true;
-        rout_b_update_zoom = true;
+    // iteration buffer, (-1, 0) = bounded, no blending of its values
+    glDisable(GL_BLEND);
+    glClearColor(-1.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    glBindVertexArray(quadVAO);
+
+    if (!g_b_tile_modes) {
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        glEnable(GL_BLEND);
         return;
     }
-     
-    rout_b_update_zoom = (r_mov_.zoomIn || r_mov_.zoomOut);
-    rout_b_update_cam = (r_mov_.moveDown || r_mov_.moveUp || r_mov_.moveLeft || r_mov_.moveRight);
 
-    // camera translation
-    double _pan = r_cam_.currentPanningSpeed;
-    if (r_mov_.moveRight) {  
-        r_cam_.cameraTranslationX += _pan;
-    }
-    else if (r_mov_.moveLeft) {
-     
-        //4qprintf("[Left] a) %.25lf\n", r_cam_.cameraTranslationX);
+    // each tile in its own precision mode, the quad is clipped to the tile
+    GLint _viewport[4];
+    glGetIntegerv(GL_VIEWPORT, _viewport);
 
-        //long double A = r_cam_.cameraTranslationX;
-        //long double B = _pan;
+    glEnable(GL_SCISSOR_TEST);
 
-        //if (A < -1.0) {
-            //long double C = A + 1.0;
-            //printf("       *)  LD  C: %.25lf - B:%.25lf\n", C, B);   
-            //C = C - B;
-            //printf("       *)  LD  C: %.25lf\n", C);
-        //}
-        //printf("       b)  LD  A: %.25lf - B:%.25lf\n", A, B);
-        //A = A - B;
+    for (int _mode = 0; _mode < 4; ++_mode) {
+        bool _b_mode_set = false;
 
-        r_cam_.cameraTranslationX   = r_cam_.cameraTranslationX - _pan;
-        //printf("       c) A: %.25lf,  %.25lf\n",A, r_cam_.cameraTranslationX);
-    }
+        for (int _ty = 0; _ty < TILE_GRID; ++_ty) {
+            for (int _tx = 0; _tx < TILE_GRID; ++_tx) {
+                if (g_tile_modes[_ty * TILE_GRID + _tx] != _mode) {
+                    continue;
+                }
+                if (!_b_mode_set) {
+                    gp_mdb_shader->set_int("u_Mode", _mode);
+                    _b_mode_set = true;
+                }
 
-    if (r_mov_.moveUp) { 
-        r_cam_.cameraTranslationY +=   _pan;
-    }
-    else if (r_mov_.moveDown) {
-        r_cam_.cameraTranslationY -=  _pan;
-    }
+                int _x0 = _viewport[0] + _viewport[2] * _tx / TILE_GRID;
+                int _x1 = _viewport[0] + _viewport[2] * (_tx + 1) / TILE_GRID;
+                int _y0 = _viewport[1] + _viewport[3] * _ty / TILE_GRID;
+                int _y1 = _viewport[1] + _viewport[3] * (_ty + 1) / TILE_GRID;
 
-    // camera zoom
-    if (r_mov_.zoomIn) {
-        r_cam_.cameraZoom = r_cam_.cameraZoom * r_cam_.zoomSpeed; // Update the zoomAmount
-        if (r_cam_.cameraZoom < 1) {
-            r_cam_.cameraZoom = 1;
+                glScissor(_x0, _y0, _x1 - _x0, _y1 - _y0);
+                glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+            }
         }
+    }
 
-        r_cam_.currentPanningSpeed = r_cam_.basePanningSpeed / r_cam_.cameraZoom; // Update camera panning speed
-        //printf("[pan] %.20lf\n", r_cam_.currentPanningSpeed);
+    glDisable(GL_SCISSOR_TEST);
+    glEnable(GL_BLEND);
+    return;
+}
 
+/**
+ * @brief Colour an iteration buffer with the palette, into the bound framebuffer,
+ * upscaled to the viewport, (edge-aware, see colour_shader.fs.glsl).
+ *
+ * With histogram equalisation, the histogram of the buffer is computed first,
+ * except for the samples of the supersampling and the fovea, coloured with the
+ * CDF of the frame.
+ *
+ * @param[in] iter_texture_, iteration buffer, g_mdb_texture, g_iter_texture or g_sample_texture
+ * @param[in] wd_, ht_, size of the iteration buffer
+ * @param[in] b_masked_, only the pixels of the edge mask, (supersampling)
+ * @param[in] b_keep_cdf_, coloured with the CDF of the frame, (part of it)
+ */
+void render_colour_pass(GLuint iter_texture_, int wd_, int ht_, bool b_masked_, bool b_keep_cdf_)
+{
+    if (g_b_equalise && !b_masked_ && !b_keep_cdf_) {
+        update_histogram(iter_texture_, wd_, ht_);
     }
-    else if (r_mov_.zoomOut) {
-        r_cam_.cameraZoom = r_cam_.cameraZoom  / r_cam_.zoomSpeed; // Update the zoomAmount
 
-        if (r_cam_.cameraZoom < 1) {
-            r_cam_.cameraZoom = 1;
-        }
+    gp_colour_shader->use_shader();
+    gp_colour_shader->set_int("u_Equalise", g_b_equalise ? 1 : 0);
+    gp_colour_shader->set_int("u_Masked", b_masked_ ? 1 : 0);
+    gp_colour_shader->set_vec2("u_TexScale", texture_scale(iter_texture_, wd_, ht_));
 
-        r_cam_.currentPanningSpeed = r_cam_.basePanningSpeed / r_cam_.cameraZoom; // Update camera panning speed
+    // coarser than the target, edge-aware upsampling
+    GLint _viewport[4];
+    glGetIntegerv(GL_VIEWPORT, _viewport);
+    gp_colour_shader->set_int("u_Upsample", (_viewport[2] > wd_ || _viewport[3] > ht_) ? 1 : 0);
+
+    if (b_masked_) {
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, g_edge_mask);
     }
 
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_1D, g_palette_texture);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, iter_texture_); // Bind Mandelbrot texture to read from
+
+    glBindVertexArray(quadVAO);
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
     return;
 }
 
 /**
- * @brief   
+ * @brief Colour the iteration atlas of the Julia set thumbnails, with the
+ * colouring pass of the view, (its palette and equalisation).
+ *
+ * With histogram equalisation, the CDF is of the whole atlas, the view
+ * computes its own again on return.
+ *
+ * @param[in] max_iter_, current max iteration
  */
-static void mouse_callback(GLFWwindow* window, int button, int action, int mods)
+void colour_julia_atlas(int max_iter_)
 {
-    if (button == GLFW_MOUSE_BUTTON_LEFT) {
-        if (action == GLFW_PRESS) {
-            g_isDragging = true;
-            glfwGetCursorPos(window, &g_previousX, &g_previousY);
-        }
-        else if (action == GLFW_RELEASE) {
+    update_colour_params(max_iter_);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, gp_julia_atlas->colour_FBO());
+    glViewport(0, 0, gp_julia_atlas->width(), gp_julia_atlas->height());
+    glDisable(GL_BLEND);
+
+    render_colour_pass(gp_julia_atlas->iter_texture(), gp_julia_atlas->width(), gp_julia_atlas->height());
+
+    glEnable(GL_BLEND);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return;
+}
+
+/**
+ * @brief Foveated rendering, the squares around the crosshair of FOVEA_SIDE and 
+ * FOVEA_FACTOR, coarse to fine, over the sub-resolution render in the view image.
+ *
+ * The levels are rendered in g_iter_texture, at their resolution, it is 
+ * rendered again by the next idle frame. All tiles in the frame mode.
+ *
+ * @param[in] mode_, precision mode of the frame, (the highest of its tiles)
+ */
+void render_fovea(int mode_)
+{
+    glEnable(GL_SCISSOR_TEST);
+
+    for (int _k = 0; _k < FOVEA_LEVELS; ++_k) {
+        int _f = FOVEA_FACTOR[_k];
+        int _wd = g_scrn_wd / _f;
+        int _ht = g_scrn_ht / _f;
+
+        // the square, in pixels of the level
+        int _half = std::max(_wd, _ht) / (2 * FOVEA_SIDE[_k]);
+        int _x0 = std::max(_wd / 2 - _half, 0);
+        int _x1 = std::min(_wd / 2 + _half, _wd);
+        int _y0 = std::max(_ht / 2 - _half, 0);
+        int _y1 = std::min(_ht / 2 + _half, _ht);
+
+        gp_mdb_shader->use_shader();
+        gp_mdb_shader->set_int("u_Mode", mode_);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, g_iter_FBO);
+        glViewport(0, 0, _wd, _ht);
+        glScissor(_x0, _y0, _x1 - _x0, _y1 - _y0);
+
+        glDisable(GL_BLEND);
+        glBindVertexArray(quadVAO);
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        glEnable(GL_BLEND);
+
+        // the view pixels whose centres fall in the square
+        int _vx0 = (_x0 * g_scrn_wd + _wd - 1) / _wd;
+        int _vx1 = _x1 * g_scrn_wd / _wd;
+        int _vy0 = (_y0 * g_scrn_ht + _ht - 1) / _ht;
+        int _vy1 = _y1 * g_scrn_ht / _ht;
+
+        glBindFramebuffer(GL_FRAMEBUFFER, g_view_FBO);
+        glViewport(0, 0, g_scrn_wd, g_scrn_ht);
+        glScissor(_vx0, _vy0, _vx1 - _vx0, _vy1 - _vy0);
+
+        render_colour_pass(g_iter_texture, _wd, _ht, false, true);
+    }
+
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return;
+}
+
+/**
+ * @brief Render factor of a movement frame, CHECKER_FACTOR while the view moves
+ * by at most CHECKER_MAX_SHIFT_PX per frame, else SUB_RENDER_FACTOR.
+ *
+ * @param[in] cam_, camera of the frame
+ * @param[in] prev_cam_, camera of the last frame
+ */
+auto movement_factor(const Input::Screen_Camera_t& cam_, const Input::Screen_Camera_t& prev_cam_)-> int
+{
+    double _px = fe_to_double(fe_div(4.0, cam_.cameraZoom)) / g_scrn_wd;
+    double _py = fe_to_double(fe_div(4.0, cam_.cameraZoom)) / g_scrn_ht;
+    double _dx = std::abs(dd_sub(cam_.cameraTranslationX, prev_cam_.cameraTranslationX).val) / _px;
+    double _dy = std::abs(dd_sub(cam_.cameraTranslationY, prev_cam_.cameraTranslationY).val) / _py;
+
+    // the view edges move by half the view size times ln(zoom change)
+    double _dz = std::abs(std::log(fe_to_double(fe_div(cam_.cameraZoom, prev_cam_.cameraZoom))))
+        * 0.5 * std::max(g_scrn_wd, g_scrn_ht);
+
+    return (std::max({ _dx, _dy, _dz }) <= CHECKER_MAX_SHIFT_PX) ? CHECKER_FACTOR : SUB_RENDER_FACTOR;
+}
+
+/**
+ * @brief Sub-pixel offset of the next movement frame, R2 sequence, or the
+ * 2x2 view pixels in turn for the interleaved frames.
+ *
+ * @param[in] factor_, render factor of the frame
+ * @return offset in pixels of the frame, in [-0.5, 0.5)
+ */
+auto next_taa_jitter(int factor_)-> glm::vec2
+{
+    int _k = g_taa_frame;
+    g_taa_frame = (g_taa_frame + 1) % (SUB_RENDER_FACTOR * SUB_RENDER_FACTOR);
+
+    if (factor_ == CHECKER_FACTOR) {
+        // the diagonals first, a checkerboard every 2 frames
+        constexpr float _offs[4][2] = { { -.25f, -.25f }, { .25f, .25f }, { .25f, -.25f }, { -.25f, .25f } };
+        return glm::vec2(_offs[_k % 4][0], _offs[_k % 4][1]);
+    }
+
+    double _ox = std::fmod(0.5 + _k * 0.7548776662466927, 1.0) - 0.5;
+    double _oy = std::fmod(0.5 + _k * 0.5698402909980532, 1.0) - 0.5;
+
+    return glm::vec2(float(_ox), float(_oy));
+}
+
+/**
+ * @brief Temporal upscaling of a jittered movement frame, blended into the 
+ * history reprojected to the camera, then copied into the view image.
+ *
+ * Without history, (after a mode or colour change, or with histogram
+ * equalisation), the frame is the edge-aware upsampling of its samples.
+ *
+ * @param[in] iter_texture_, iteration buffer of the frame, g_mdb_texture or g_checker_texture
+ * @param[in] factor_, its render factor
+ * @param[in] cam_, camera of the frame
+ * @param[in] jitter_, offset of its samples, in its pixels
+ * @param[in] max_iter_, current max iteration
+ */
+void render_temporal_upscale(GLuint iter_texture_, int factor_, const Input::Screen_Camera_t& cam_, const glm::vec2& jitter_, int max_iter_)
+{
+    int _wd = g_scrn_wd / factor_;
+    int _ht = g_scrn_ht / factor_;
+
+    // the sample colours, (and the CDF of the frame)
+    glBindFramebuffer(GL_FRAMEBUFFER, g_taa_sample_FBO);
+    glViewport(0, 0, _wd, _ht);
+    render_colour_pass(iter_texture_, _wd, _ht);
+
+    // the prior, upsampled into the view image
+    glBindFramebuffer(GL_FRAMEBUFFER, g_view_FBO);
+    glViewport(0, 0, g_scrn_wd, g_scrn_ht);
+
+    gp_colour_shader->use_shader();
+    gp_colour_shader->set_vec2("u_SampleOffset", jitter_);
+    render_colour_pass(iter_texture_, _wd, _ht, false, true);
+    gp_colour_shader->use_shader();
+    gp_colour_shader->set_vec2("u_SampleOffset", glm::vec2(0.f, 0.f));
+
+    if (g_b_equalise || max_iter_ != g_history_max_iter) {
+        g_b_history = false;
+    }
+
+    // history position of a view position, in [0, 1], same plane point
+    glm::vec4 _map(1.f, 1.f, 0.f, 0.f);
+    float _gain = 1.f;
+    if (g_b_history) {
+        double _s = fe_to_double(fe_div(g_history_cam.cameraZoom, cam_.cameraZoom));
+        double _half = fe_to_double(fe_div(2.0, g_history_cam.cameraZoom));
+        double _ox = dd_sub(cam_.cameraTranslationX, g_history_cam.cameraTranslationX).val / (2. * _half);
+        double _oy = dd_sub(cam_.cameraTranslationY, g_history_cam.cameraTranslationY).val / (2. * _half);
+
+        _map = glm::vec4(float(_s), float(_s), float(0.5 - 0.5 * _s + _ox), float(0.5 - 0.5 * _s + _oy));
+
+        // zooming in, a history pixel spreads over more view pixels
+        _gain = g_history_gain * float(std::min(_s * _s, 1.0));
+    }
+
+    int _next = 1 - g_history;
+
+    gp_taa_shader->use_shader();
+    gp_taa_shader->set_ivec2("u_SampleSize", _wd, _ht);
+    gp_taa_shader->set_ivec2("u_Size", g_scrn_wd, g_scrn_ht);
+    gp_taa_shader->set_float("u_Factor", float(factor_));
+    gp_taa_shader->set_vec2("u_Jitter", jitter_);
+    // an eighth of the sample spacing, the interleaved samples do not spill into their neighbours
+    gp_taa_shader->set_float("u_SampleSigma", 0.125f * factor_);
+    gp_taa_shader->set_int("u_HistoryValid", g_b_history ? 1 : 0);
+    gp_taa_shader->set_vec4("u_HistoryMap", _map);
+    gp_taa_shader->set_vec2("u_HistoryTexScale", texture_scale(g_history_texture[g_history], g_scrn_wd, g_scrn_ht));
+    gp_taa_shader->set_float("u_HistoryGain", _gain);
+
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, g_history_texture[g_history]);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, g_view_texture);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, g_taa_sample_texture);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, g_history_FBO[_next]);
+    glDisable(GL_BLEND);
+    glBindVertexArray(quadVAO);
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    glEnable(GL_BLEND);
+
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    g_history = _next;
+    g_history_cam = cam_;
+    g_history_max_iter = max_iter_;
+    g_history_gain = 1.f;
+    g_b_history = true;
+
+    // into the view image
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, g_history_FBO[g_history]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, g_view_FBO);
+    glBlitFramebuffer(
+        0, 0, g_scrn_wd, g_scrn_ht,
+        0, 0, g_scrn_wd, g_scrn_ht,
+        GL_COLOR_BUFFER_BIT,
+        GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return;
+}
+
+/**
+ * @brief Seed the history of the temporal upscaling with the view image, a
+ * full resolution frame, worth HISTORY_SEED_WEIGHT samples.
+ *
+ * @param[in] cam_, camera of the frame
+ * @param[in] max_iter_, its max iteration
+ */
+void seed_history(const Input::Screen_Camera_t& cam_, int max_iter_)
+{
+    if (g_ssaa_sample == 0 || g_b_equalise || g_b_resize_pending) {
+        return;
+    }
+
+    // the view alpha is 1, one sample
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, g_view_FBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, g_history_FBO[g_history]);
+    glBlitFramebuffer(
+        0, 0, g_scrn_wd, g_scrn_ht,
+        0, 0, g_scrn_wd, g_scrn_ht,
+        GL_COLOR_BUFFER_BIT,
+        GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    g_history_cam = cam_;
+    g_history_max_iter = max_iter_;
+    g_history_gain = HISTORY_SEED_WEIGHT;
+    g_b_history = true;
+    return;
+}
+
+/**
+ * @brief Start the supersampling of the full resolution frame: its colours are
+ * the first sample of the accumulation buffer, and its edge pixels are marked, 
+ * and counted.
+ */
+void begin_supersampling()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, g_accum_FBO);
+    glViewport(0, 0, g_scrn_wd, g_scrn_ht);
+
+    glDisable(GL_BLEND);
+    render_colour_pass(g_iter_texture, g_scrn_wd, g_scrn_ht);
+    glEnable(GL_BLEND);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_ssaa_active_SSBO);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    gp_ssaa_edge_shader->use_shader();
+    gp_ssaa_edge_shader->set_ivec2("u_Size", g_scrn_wd, g_scrn_ht);
+    glBindImageTexture(0, g_iter_texture, 0, GL_FALSE, 0, GL_READ_ONLY, GL_RG32F);
+    glBindImageTexture(1, g_edge_mask, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R8);
+    glDispatchCompute((g_scrn_wd + 15) / 16, (g_scrn_ht + 15) / 16, 1);
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    g_ssaa_sample = 1;
+    update_ssaa_active();
+    return;
+}
+
+/**
+ * @brief Render one more sample of the edge pixels, at a sub-pixel offset, 
+ * and add its colours to the accumulation buffer, then clear the converged
+ * pixels from the edge mask.
+ *
+ * The other pixels are discarded before iterating, the cost is the share of
+ * the edge pixels left in the frame.
+ */
+void render_supersample()
+{
+    // R2 sequence, offsets in [-0.5, 0.5) pixel, the first one (0, 0)
+    double _ox = std::fmod(0.5 + g_ssaa_sample * 0.7548776662466927, 1.0) - 0.5;
+    double _oy = std::fmod(0.5 + g_ssaa_sample * 0.5698402909980532, 1.0) - 0.5;
+
+    gp_mdb_shader->use_shader();
+    gp_mdb_shader->set_vec2("u_Jitter", glm::vec2(2.0 * _ox / g_scrn_wd, 2.0 * _oy / g_scrn_ht));
+    gp_mdb_shader->set_int("u_Masked", 1);
+
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, g_edge_mask);
+    glActiveTexture(GL_TEXTURE0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, g_sample_FBO);
+    glViewport(0, 0, g_scrn_wd, g_scrn_ht);
+    render_mandelbrot();
+
+    gp_mdb_shader->use_shader();
+    gp_mdb_shader->set_vec2("u_Jitter", glm::vec2(0.f, 0.f));
+    gp_mdb_shader->set_int("u_Masked", 0);
+
+    // sum of the sample colours, alpha counts the samples
+    glBindFramebuffer(GL_FRAMEBUFFER, g_accum_FBO);
+    glBlendFunc(GL_ONE, GL_ONE);
+    render_colour_pass(g_sample_texture, g_scrn_wd, g_scrn_ht, true);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    ++g_ssaa_sample;
+
+    // convergence, (the pixels at SSAA_MAX_SAMPLES are stopped by the caller)
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_ssaa_active_SSBO);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+    gp_ssaa_converge_shader->use_shader();
+    gp_ssaa_converge_shader->set_ivec2("u_Size", g_scrn_wd, g_scrn_ht);
+    glBindImageTexture(0, g_accum_texture, 0, GL_FALSE, 0, GL_READ_ONLY, GL_RGBA32F);
+    glBindImageTexture(1, g_moment_texture, 0, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+    glBindImageTexture(2, g_edge_mask, 0, GL_FALSE, 0, GL_READ_WRITE, GL_R8);
+    glDispatchCompute((g_scrn_wd + 15) / 16, (g_scrn_ht + 15) / 16, 1);
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    update_ssaa_active();
+    return;
+}
+
+/**
+ * @brief Read back the count of the pixels still sampled, (4 bytes, once per idle frame).
+ */
+void update_ssaa_active()
+{
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_ssaa_active_SSBO);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &g_ssaa_active);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    return;
+}
+
+/**
+ * @brief The mean of the samples of each pixel, into the view image.
+ */
+void resolve_supersampling()
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, g_view_FBO);
+    glViewport(0, 0, g_scrn_wd, g_scrn_ht);
+
+    gp_ssaa_resolve_shader->use_shader();
+    gp_ssaa_resolve_shader->set_vec2("u_TexScale", texture_scale(g_accum_texture, g_scrn_wd, g_scrn_ht));
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, g_accum_texture);
+
+    glBindVertexArray(quadVAO);
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return;
+}
+
+/**
+ * @brief Draw the view image (or the Julia atlas) and the crosshair, into the
+ * default framebuffer.
+ *
+ * No rendering, a blit and the crosshair, for redraws and window refresh events.
+ * While a resize settles, the view image is rescaled to the window.
+ */
+void composite_view()
+{
+    glViewport(0, 0, g_win_wd, g_win_ht);
+
+    if (g_b_atlas) {
+        gp_julia_atlas->draw(g_win_wd, g_win_ht);
+    }
+    else {
+        bool _b_same_size = (g_win_wd == g_scrn_wd && g_win_ht == g_scrn_ht);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, g_view_FBO);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        glBlitFramebuffer(
+            0, 0, g_scrn_wd, g_scrn_ht,
+            0, 0, g_win_wd, g_win_ht,
+            GL_COLOR_BUFFER_BIT,
+            _b_same_size ? GL_NEAREST : GL_LINEAR);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+    if (g_b_xhair) {
+        render_crosshair();
+    }
+    return;
+}
+
+/**
+ * @brief Keep the view image, a full resolution frame, for the reprojection.
+ *
+ * Not with histogram equalisation, the sub-resolution colours around it would
+ * come from another CDF, nor while a resize settles.
+ *
+ * @param[in] cam_, camera of the frame
+ */
+void save_reprojection(const Input::Screen_Camera_t& cam_)
+{
+    g_b_reproj = (g_ssaa_sample > 0 && !g_b_equalise && !g_b_resize_pending);
+    if (!g_b_reproj) {
+        return;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, g_view_FBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, g_reproj_FBO);
+    glBlitFramebuffer(
+        0, 0, g_scrn_wd, g_scrn_ht,
+        0, 0, g_scrn_wd, g_scrn_ht,
+        GL_COLOR_BUFFER_BIT,
+        GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    g_reproj_cam = cam_;
+    return;
+}
+
+/**
+ * @brief Copy the kept full resolution frame into the view image, shifted by
+ * the camera motion since, if it is whole pixels, (same zoom).
+ *
+ * @param[in] cam_, current camera
+ * @return true if the frame was reprojected
+ */
+auto reproject_last_frame(const Input::Screen_Camera_t& cam_)-> bool
+{
+    if (g_b_resize_pending) {
+        return false;
+    }
+
+    // shift of the content, in pixels, y up, opposite to the camera
+    double _px = fe_to_double(fe_div(4.0, cam_.cameraZoom)) / g_scrn_wd;
+    double _py = fe_to_double(fe_div(4.0, cam_.cameraZoom)) / g_scrn_ht;
+    double _ox = -dd_sub(cam_.cameraTranslationX, g_reproj_cam.cameraTranslationX).val / _px;
+    double _oy = -dd_sub(cam_.cameraTranslationY, g_reproj_cam.cameraTranslationY).val / _py;
+
+    int _dx = static_cast<int>(std::lround(_ox));
+    int _dy = static_cast<int>(std::lround(_oy));
+    if (std::abs(_ox - _dx) > 1e-3 || std::abs(_oy - _dy) > 1e-3) {
+        return false;
+    }
+
+    // the overlap of the frame and the view
+    int _wd = g_scrn_wd - std::abs(_dx);
+    int _ht = g_scrn_ht - std::abs(_dy);
+    if (_wd <= 0 || _ht <= 0) {
+        return false;
+    }
+    int _sx = std::max(-_dx, 0);
+    int _sy = std::max(-_dy, 0);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, g_reproj_FBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, g_view_FBO);
+    glBlitFramebuffer(
+        _sx, _sy, _sx + _wd, _sy + _ht,
+        _sx + _dx, _sy + _dy, _sx + _dx + _wd, _sy + _dy + _ht,
+        GL_COLOR_BUFFER_BIT,
+        GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    return true;
+}
+
+/**
+ * @brief Render the next tiles of the speculative prefetch frame, at the camera
+ * predicted PREFETCH_LEAD_SEC ahead of the keyboard motion, and colour it once
+ * complete.
+ *
+ * A frame in progress is dropped once the prediction has moved away from it, 
+ * (the direction has changed), a new one is started once the complete frame
+ * is as far behind. Not in perturbation mode, its reference orbit is at the
+ * camera, nor with histogram equalisation, as the reprojection. Only as many
+ * tiles as the frame has GPU time left for, (see prefetch_tile_budget()).
+ *
+ * @param[in] mov_, movement state, (velocity)
+ * @param[in] cam_, current camera
+ * @param[in] max_iter_, current max iteration
+ * @param[in] mode_, precision mode of the frame, (the highest of its tiles)
+ */
+void update_prefetch(const Input::Screen_Movement_t& mov_, const Input::Screen_Camera_t& cam_, int max_iter_, int mode_)
+{
+    if (max_iter_ != g_prefetch_max_iter) {
+        cancel_prefetch();
+        g_prefetch_max_iter = max_iter_;
+    }
+
+    if (mode_ == 3 || g_b_equalise || g_b_resize_pending 
+        || (mov_.velX == 0. && mov_.velY == 0. && mov_.velZoom == 0.)) {
+        g_prefetch_tile = -1;
+        return;
+    }
+
+    // camera predicted at the current velocity
+    double _half = fe_to_double(fe_div(2.0, cam_.cameraZoom));
+
+    Input::Screen_Camera_t _cam = cam_;
+    _cam.cameraTranslationX = dd_add(cam_.cameraTranslationX, dd_mul(mov_.velX * PREFETCH_LEAD_SEC, _half));
+    _cam.cameraTranslationY = dd_add(cam_.cameraTranslationY, dd_mul(mov_.velY * PREFETCH_LEAD_SEC, _half));
+    _cam.cameraZoom = cam_.cameraZoom * std::exp(mov_.velZoom * PREFETCH_LEAD_SEC);
+    if (_cam.cameraZoom < 1) {
+        _cam.cameraZoom = 1;
+    }
+
+    // distance of a frame to the prediction, view half-widths plus ln(zoom)
+    auto _distance = [&_cam, _half](const Input::Screen_Camera_t& other_) {
+        double _dx = dd_sub(other_.cameraTranslationX, _cam.cameraTranslationX).val / _half;
+        double _dy = dd_sub(other_.cameraTranslationY, _cam.cameraTranslationY).val / _half;
+        double _dz = std::log(fe_to_double(fe_div(other_.cameraZoom, _cam.cameraZoom)));
+        return std::max(std::abs(_dx), std::abs(_dy)) + std::abs(_dz);
+    };
+
+    if (g_prefetch_tile >= 0 && _distance(g_prefetch_cam) > PREFETCH_STALE) {
+        g_prefetch_tile = -1;
+    }
+    if (g_prefetch_tile < 0) {
+        if (g_b_prefetch && _distance(g_prefetch_done_cam) <= PREFETCH_STALE) {
+            return;
+        }
+        g_prefetch_cam = _cam;
+        g_prefetch_tile = 0;
+    }
+
+    int _n_tiles = prefetch_tile_budget();
+    if (_n_tiles == 0) {
+        return;
+    }
+
+    gp_mdb_shader->use_shader();
+    set_camera_uniforms(g_prefetch_cam, true, true);
+    gp_mdb_shader->set_int("u_Mode", mode_);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, g_prefetch_iter_FBO);
+    glViewport(0, 0, g_scrn_wd, g_scrn_ht);
+    glDisable(GL_BLEND);
+    glEnable(GL_SCISSOR_TEST);
+    glBindVertexArray(quadVAO);
+
+    int _last = std::min(g_prefetch_tile + _n_tiles, TILE_GRID * TILE_GRID);
+
+    glBeginQuery(GL_TIME_ELAPSED, g_prefetch_query[g_timer_frame]);
+    g_prefetch_timed_tiles[g_timer_frame] = _last - g_prefetch_tile;
+
+    for (; g_prefetch_tile < _last; ++g_prefetch_tile) {
+        int _tx = g_prefetch_tile % TILE_GRID;
+        int _ty = g_prefetch_tile / TILE_GRID;
+
+        int _x0 = g_scrn_wd * _tx / TILE_GRID;
+        int _x1 = g_scrn_wd * (_tx + 1) / TILE_GRID;
+        int _y0 = g_scrn_ht * _ty / TILE_GRID;
+        int _y1 = g_scrn_ht * (_ty + 1) / TILE_GRID;
+
+        glScissor(_x0, _y0, _x1 - _x0, _y1 - _y0);
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    }
+
+    glEndQuery(GL_TIME_ELAPSED);
+
+    glDisable(GL_SCISSOR_TEST);
+    glEnable(GL_BLEND);
+
+    // back to the camera of the view
+    set_camera_uniforms(cam_, true, true);
+
+    if (g_prefetch_tile == TILE_GRID * TILE_GRID) {
+        glBindFramebuffer(GL_FRAMEBUFFER, g_prefetch_FBO);
+        glDisable(GL_BLEND);
+        render_colour_pass(g_prefetch_iter, g_scrn_wd, g_scrn_ht);
+        glEnable(GL_BLEND);
+
+        g_prefetch_done_cam = g_prefetch_cam;
+        g_prefetch_tile = -1;
+        g_b_prefetch = true;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return;
+}
+
+/**
+ * @brief Draw the complete prefetch frame into the view image, scaled and 
+ * shifted to the current camera, to the nearest pixel.
+ *
+ * Only if it is at least as fine as the view, an upscaled frame would be
+ * coarser than the fovea and the reprojection drawn over it.
+ *
+ * @param[in] cam_, current camera
+ * @param[in] max_iter_, current max iteration
+ * @return true if the frame covers part of the view
+ */
+auto draw_prefetch(const Input::Screen_Camera_t& cam_, int max_iter_)-> bool
+{
+    // equalised colours depend on the whole frame, the prefetch frame has its own
+    if (!g_b_prefetch || g_b_equalise || max_iter_ != g_prefetch_max_iter || g_b_resize_pending) {
+        return false;
+    }
+
+    // the prefetch frame in view pixels, centre and half size
+    double _px = fe_to_double(fe_div(4.0, cam_.cameraZoom)) / g_scrn_wd;
+    double _py = fe_to_double(fe_div(4.0, cam_.cameraZoom)) / g_scrn_ht;
+    double _half = fe_to_double(fe_div(2.0, g_prefetch_done_cam.cameraZoom));
+
+    double _cx = 0.5 * g_scrn_wd + dd_sub(g_prefetch_done_cam.cameraTranslationX, cam_.cameraTranslationX).val / _px;
+    double _cy = 0.5 * g_scrn_ht + dd_sub(g_prefetch_done_cam.cameraTranslationY, cam_.cameraTranslationY).val / _py;
+    double _rx = _half / _px;
+    double _ry = _half / _py;
+
+    // at least as fine as the view, (not scaled up), and overlapping the view
+    if (2. * _rx > g_scrn_wd + 0.5 || 2. * _ry > g_scrn_ht + 0.5
+        || _cx + _rx <= 0. || _cx - _rx >= g_scrn_wd
+        || _cy + _ry <= 0. || _cy - _ry >= g_scrn_ht) {
+        return false;
+    }
+
+    bool _b_same_zoom = (std::abs(2. * _rx - g_scrn_wd) < 0.5);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, g_prefetch_FBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, g_view_FBO);
+    glBlitFramebuffer(
+        0, 0, g_scrn_wd, g_scrn_ht,
+        static_cast<GLint>(std::lround(_cx - _rx)), static_cast<GLint>(std::lround(_cy - _ry)),
+        static_cast<GLint>(std::lround(_cx + _rx)), static_cast<GLint>(std::lround(_cy + _ry)),
+        GL_COLOR_BUFFER_BIT,
+        _b_same_zoom ? GL_NEAREST : GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    return true;
+}
+
+/**
+ * @brief Drop the prefetch frames, (the colours or the mode have changed).
+ *
+ * The cost of a tile is measured again.
+ */
+void cancel_prefetch()
+{
+    g_prefetch_tile = -1;
+    g_b_prefetch = false;
+    g_prefetch_tile_sec = 0.;
+    return;
+}
+
+/**
+ * @brief Number of prefetch tiles the motion frame has time for, from the
+ * GPU times of the last motion frame and of its tiles.
+ *
+ * The timer results are read a frame late, without waiting for the GPU.
+ * A single tile is rendered while the cost of a tile is not known.
+ *
+ * @return number of tiles, 0 if the motion frame alone takes its budget
+ */
+auto prefetch_tile_budget()-> int
+{
+    int _prev = g_timer_frame ^ 1;
+    GLint _b_ready = 0;
+    GLuint64 _ns = 0;
+
+    if (g_b_motion_timed[_prev]) {
+        glGetQueryObjectiv(g_motion_query[_prev], GL_QUERY_RESULT_AVAILABLE, &_b_ready);
+        if (_b_ready) {
+            glGetQueryObjectui64v(g_motion_query[_prev], GL_QUERY_RESULT, &_ns);
+            g_motion_sec = 1e-9 * _ns;
+            g_b_motion_timed[_prev] = false;
+        }
+    }
+
+    if (g_prefetch_timed_tiles[_prev] > 0) {
+        glGetQueryObjectiv(g_prefetch_query[_prev], GL_QUERY_RESULT_AVAILABLE, &_b_ready);
+        if (_b_ready) {
+            glGetQueryObjectui64v(g_prefetch_query[_prev], GL_QUERY_RESULT, &_ns);
+            g_prefetch_tile_sec = 1e-9 * _ns / g_prefetch_timed_tiles[_prev];
+            g_prefetch_timed_tiles[_prev] = 0;
+        }
+    }
+
+    double _spare = PREFETCH_FRAME_BUDGET_SEC - g_motion_sec;
+    if (_spare <= 0.) {
+        return 0;
+    }
+    if (g_prefetch_tile_sec <= 0.) {
+        return 1;
+    }
+    return std::min(static_cast<int>(_spare / g_prefetch_tile_sec), PREFETCH_MAX_TILES_PER_FRAME);
+}
+
+/**
+ * @brief Wait for the next event when there is nothing to do, (or until a
+ * pending resize settles), else only poll.
+ *
+ * @param[in] b_wait_, nothing changed and no progressive work left
+ */
+void wait_or_poll_events(bool b_wait_)
+{
+    if (!b_wait_) {
+        glfwPollEvents();
+    }
+    else if (g_b_resize_pending) {
+        double _left = RESIZE_SETTLE_SEC - (glfwGetTime() - g_resize_time);
+        glfwWaitEventsTimeout(std::max(_left, 0.001));
+    }
+    else {
+        glfwWaitEvents();
+    }
+    return;
+}
+
+/**
+ * @brief Histogram of the escape iterations of an iteration buffer, and its CDF,
+ * into g_cdf_SSBO, on the GPU, (no read back).
+ *
+ * @param[in] iter_texture_, iteration buffer
+ * @param[in] wd_, ht_, size of the iteration buffer
+ */
+void update_histogram(GLuint iter_texture_, int wd_, int ht_)
+{
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, g_histogram_SSBO);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // a work group counts a 32x32 block
+    gp_histogram_shader->use_shader();
+    gp_histogram_shader->set_ivec2("u_Size", wd_, ht_);
+    glBindImageTexture(0, iter_texture_, 0, GL_FALSE, 0, GL_READ_ONLY, GL_RG32F);
+    glDispatchCompute((wd_ + 31) / 32, (ht_ + 31) / 32, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // prefix sum, one work group
+    gp_histogram_cdf_shader->use_shader();
+    glDispatchCompute(1, 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    return;
+}
+
+/**
+ * @brief Iteration limit of the colouring pass and the histogram, the bins span [0, max_iter_).
+ *
+ * @param[in] max_iter_, current max iteration
+ */
+void update_colour_params(int max_iter_)
+{
+    gp_histogram_shader->use_shader();
+    gp_histogram_shader->set_float("u_MaxIter", float(max_iter_));
+
+    gp_colour_shader->use_shader();
+    gp_colour_shader->set_float("u_MaxIter", float(max_iter_));
+    return;
+}
+
+/**
+ * @brief Build a palette and upload it to the palette texture.
+ *
+ * @param[in] palette_, [0, N_PALETTES)
+ */
+void upload_palette(int palette_)
+{
+    std::vector<float> _rgb;
+    build_palette(palette_, _rgb);
+
+    glBindTexture(GL_TEXTURE_1D, g_palette_texture);
+    glTexImage1D(GL_TEXTURE_1D, 0, GL_RGB8, PALETTE_SIZE, 0, GL_RGB, GL_FLOAT, _rgb.data());
+
+    // smooth between the entries, and one colour cycle after the other
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glBindTexture(GL_TEXTURE_1D, 0);
+    return;
+}
+
+/**
+ * @brief Update the windows title bar with status info.
+ *
+ * @param[in] *window_, pointer to window object
+ * @param[in] fps_, frame-rate
+ * @param[in] max_iter_, current max iteration set 
+ * @param[in] precision_mode_, current rendering precision mode [0,1,2,3] 
+ * @param[in] b_auto_mode_, precision mode is selected automatically
+ * @param[in] b_julia_, rendering the Julia set
+ */
+void render_window_title(GLFWwindow* window_, float fps_, int max_iter_, int precision_mode_, bool b_auto_mode_, bool b_julia_)
+{
+    //std::string msStr = std::to_string((timeDiff / counter) * 1000);
+    std::string newTitle = 
+        ( std::format("{:.1f}", fps_) 
+            + "fps, max:"
+            + std::format("{}", max_iter_) );
+
+    if (precision_mode_ == 0) {
+        newTitle += ", S";
+    } else if (precision_mode_ == 1) {
+        newTitle += ", dS";
+    } else if (precision_mode_ == 2) {
+        newTitle += ", dD";
+    } else if (precision_mode_ == 3) {
+        newTitle += ", P";
+    }
+
+    if (b_auto_mode_) {
+        newTitle += " (auto)";
+    }
+
+    if (b_julia_) {
+        newTitle += ", Julia";
+    }
+
+    glfwSetWindowTitle(window_, newTitle.c_str());
+
+    return;
+
+}
+
+/**
+ * @brief Select the cheapest precision mode that resolves the pixel spacing.
+ *
+ * The bits needed are those between the largest magnitude in the iteration
+ * and the pixel spacing.
+ * Going back to a cheaper mode needs PRECISION_HYSTERESIS_BITS to spare.
+ *
+ * @param[in] magnitude_, largest |c| (or |z|) of the pixels
+ * @param[in] spacing_, pixel spacing in the complex plane
+ * @param[in] mode_, current precision mode [0,1,2,3]
+ *
+ * @return precision mode [0,1,2,3]
+ */
+auto select_precision_mode(double magnitude_, const floatExp& spacing_, int mode_)-> int
+{
+    double _bits = std::log2(magnitude_) - fe_log2(spacing_);
+
+    for (int _m = 0; _m < 3; ++_m) {
+        int _limit = PRECISION_MODE_BITS[_m] - ((_m < mode_) ? PRECISION_HYSTERESIS_BITS : 0);
+        if (_bits <= _limit) {
+            return _m;
+        }
+    }
+    return 3;
+}
+
+/**
+ * @brief Select the precision mode of each tile of the view, into g_tile_modes.
+ *
+ * The magnitude of a tile is |c| at its farthest corner, so tiles near the
+ * origin stay in a cheaper mode than those near |c| = 2 at the same zoom.
+ *
+ * @param[in] cam_, camera state
+ * @param[in] wd_, width of the view in pixels, at full resolution
+ * @param[in] max_mode_, highest mode allowed, 2 in Julia mode
+ *
+ * @return the highest mode of the tiles, the mode of the frame
+ */
+auto select_tile_modes(const Input::Screen_Camera_t& cam_, int wd_, int max_mode_)-> int
+{
+    // pixel spacing, the view is (4 / cameraZoom) wide
+    floatExp _spacing = fe_div(4.0, fe_mul(cam_.cameraZoom, floatExp(double(wd_))));
+
+    // half-width of the view, 0 past the double range, the tiles are then all at the camera
+    double _half = fe_to_double(fe_div(2.0, cam_.cameraZoom));
+
+    int _frame_mode = 0;
+
+    for (int _ty = 0; _ty < TILE_GRID; ++_ty) {
+        double _y0 = cam_.cameraTranslationY.val + _half * (-1. + 2. * _ty / TILE_GRID);
+        double _y1 = cam_.cameraTranslationY.val + _half * (-1. + 2. * (_ty + 1) / TILE_GRID);
+
+        for (int _tx = 0; _tx < TILE_GRID; ++_tx) {
+            double _x0 = cam_.cameraTranslationX.val + _half * (-1. + 2. * _tx / TILE_GRID);
+            double _x1 = cam_.cameraTranslationX.val + _half * (-1. + 2. * (_tx + 1) / TILE_GRID);
+
+            double _magnitude = std::max(
+                std::hypot(std::max(std::abs(_x0), std::abs(_x1)), std::max(std::abs(_y0), std::abs(_y1))),
+                TILE_MIN_MAGNITUDE);
+
+            int& _mode = g_tile_modes[_ty * TILE_GRID + _tx];
+            _mode = std::min(select_precision_mode(_magnitude, _spacing, _mode), max_mode_);
+
+            _frame_mode = std::max(_frame_mode, _mode);
+        }
+    }
+    return _frame_mode;
+}
+
+/**
+ * @brief Callback function for window refresh event
+ */
+static void window_refresh_callback( GLFWwindow* window)
+{
+    // the last frame, (rescaled during a resize), no rendering and no glFinish, 
+    // dragging the window edge does not wait on the Mandelbrot
+    composite_view();
+    glfwSwapBuffers(window);
+}
+
+/**
+ * @brief Callback function for window size change event
+ */
+static void win_resize_callback(GLFWwindow* window, int w, int h)
+{ 
+    // the render textures are resized by the main loop once the size settles,
+    // (resize_render_textures())
+    g_win_wd = w;
+    g_win_ht = h;
+    g_b_resize_pending = true;
+    g_resize_time = glfwGetTime();
+
+    // Future: Maintain 1:1 pixel-aspect ratio for non 1:1 window-aspect ratio
+    //if (w > h) {
+    //   glViewport(0, (h - w) / 2, w, w);
+    //}
+    //else {
+    //    glViewport((w - h) / 2, 0, h, h);
+    //}
+    return;
+}
+
+
+/**
+ * @brief  Callback function for key events
+ */
+static void key_callback(GLFWwindow* win, int key, int scancode, int action, int mods)
+{
+    // Handle key events using Input class
+    Input* input = (Input*)glfwGetWindowUserPointer(win);
+    input->check_keys(win, key, scancode, action, mods);
+    return;
+}
+
+/**
+ * @brief Update the camera from the user input, keyboard motion integrated over the frame time.
+ *
+ * The keys set a target velocity, the smoothed velocity follows it and coasts
+ * to a stop after they are released, (inertia). Mouse drags and wheel steps
+ * are applied as they are.
+ *
+ * @param[out] rout_b_update_cam, the camera position has changed
+ * @param[out] rout_b_update_zoom, the zoom has changed
+ * @param[in] dt_, frame time, seconds
+ * @param[in,out] r_mov_, movement state, (velocity, accumulated mouse input)
+ * @param[in,out] r_cam_, camera state
+ */
+void update_camera(
+    bool& rout_b_update_cam,
+    bool& rout_b_update_zoom,
+    double dt_,
+    Input::Screen_Movement_t& r_mov_,
+    Input::Screen_Camera_t& r_cam_)
+{
+    if (r_mov_.reset_view) {
+        r_cam_ = {}; // Use designated initializer to reset to default values
+        r_mov_.velX = 0.;
+        r_mov_.velY = 0.;
+        r_mov_.velZoom = 0.;
+        rout_b_update_cam  = true;
+        rout_b_update_zoom = true;
+        return;
+    }
+     
+    rout_b_update_zoom = false;
+    rout_b_update_cam = false;
+
+    // mouse drag, the plane point under the cursor follows it, 
+    // pixels * pixel size is exact in double-double, (the view spans 4 / zoom on each axis)
+    if (r_mov_.dragX != 0. || r_mov_.dragY != 0.) {
+        double _px = fe_to_double(fe_div(4.0, r_cam_.cameraZoom)) / g_win_wd;
+        double _py = fe_to_double(fe_div(4.0, r_cam_.cameraZoom)) / g_win_ht;
+
+        r_cam_.cameraTranslationX = dd_sub(r_cam_.cameraTranslationX, dd_mul(r_mov_.dragX, _px));
+        r_cam_.cameraTranslationY = dd_add(r_cam_.cameraTranslationY, dd_mul(r_mov_.dragY, _py));
+
+        r_mov_.dragX = 0.;
+        r_mov_.dragY = 0.;
+        rout_b_update_cam = true;
+    }
+
+    // mouse wheel, zoom about the cursor, the plane point under it stays there
+    if (r_mov_.scroll != 0.) {
+        floatExp _zoom = r_cam_.cameraZoom * std::pow(SCROLL_ZOOM_FACTOR, r_mov_.scroll);
+        if (_zoom < 1) {
+            _zoom = 1;
+        }
+
+        // cursor in [-1, 1], y up, the view spans 2 / zoom each side
+        double _nx = 2. * r_mov_.scrollX / g_win_wd - 1.;
+        double _ny = 1. - 2. * r_mov_.scrollY / g_win_ht;
+        double _dk = fe_to_double(fe_div(2.0, r_cam_.cameraZoom)) - fe_to_double(fe_div(2.0, _zoom));
+
+        r_cam_.cameraTranslationX = dd_add(r_cam_.cameraTranslationX, dd_mul(_nx, _dk));
+        r_cam_.cameraTranslationY = dd_add(r_cam_.cameraTranslationY, dd_mul(_ny, _dk));
+        r_cam_.cameraZoom = _zoom;
+
+        r_mov_.scroll = 0.;
+        rout_b_update_cam = true;
+        rout_b_update_zoom = true;
+    }
+
+    // keyboard, target velocity
+    double _tx = (r_mov_.moveRight ? 1. : 0.) - (r_mov_.moveLeft ? 1. : 0.);
+    double _ty = (r_mov_.moveUp ? 1. : 0.) - (r_mov_.moveDown ? 1. : 0.);
+    double _tz = (r_mov_.zoomIn ? 1. : 0.) - (r_mov_.zoomOut ? 1. : 0.);
+
+    // exponential smoothing over dt_, the same path at any frame rate
+    double _k = 1. - std::exp(-dt_ / MOTION_TAU_SEC);
+    auto _follow = [_k](double& r_vel_, double target_) {
+        r_vel_ += (target_ - r_vel_) * _k;
+        if (target_ == 0. && std::abs(r_vel_) < MOTION_STOP) {
+            r_vel_ = 0.;
+        }
+    };
+    _follow(r_mov_.velX, _tx * r_cam_.panSpeed);
+    _follow(r_mov_.velY, _ty * r_cam_.panSpeed);
+    _follow(r_mov_.velZoom, _tz * r_cam_.zoomRate);
+
+    // camera translation
+    if (r_mov_.velX != 0. || r_mov_.velY != 0.) {
+        double _half = fe_to_double(fe_div(2.0, r_cam_.cameraZoom));
+
+        r_cam_.cameraTranslationX = dd_add(r_cam_.cameraTranslationX, dd_mul(r_mov_.velX * dt_, _half));
+        r_cam_.cameraTranslationY = dd_add(r_cam_.cameraTranslationY, dd_mul(r_mov_.velY * dt_, _half));
+        rout_b_update_cam = true;
+    }
+
+    // camera zoom
+    if (r_mov_.velZoom != 0.) {
+        r_cam_.cameraZoom = r_cam_.cameraZoom * std::exp(r_mov_.velZoom * dt_);
+        if (r_cam_.cameraZoom < 1) {
+            r_cam_.cameraZoom = 1;
+            r_mov_.velZoom = 0.;
+        }
+        rout_b_update_zoom = true;
+    }
+
+    return;
+}
+
+/**
+ * @brief   
+ */
+static void mouse_callback(GLFWwindow* window, int button, int action, int mods)
+{
+    if (button == GLFW_MOUSE_BUTTON_LEFT) {
+        if (action == GLFW_PRESS) {
+            g_isDragging = true;
+            glfwGetCursorPos(window, &g_previousX, &g_previousY);
+        }
+        else if (action == GLFW_RELEASE) {
             g_isDragging = false;
         }
     }
@@ -706,12 +2466,9 @@ static void mouse_callback(GLFWwindow* window, int button, int action, int mods)
 static void cursor_pos_callback(GLFWwindow* window, double xpos, double ypos) {
 
     if (g_isDragging) {
-        // Calculate panning distance
-        double deltaX = xpos - g_previousX;
-        double deltaY = ypos - g_previousY;
-
-        // Update camera or viewport position based on panning distance
-        // For example, update camera translation or viewport coordinates
+        // Calculate panning distance, applied to the camera by update_camera()
+        g_input.m_scrn_mov.dragX += xpos - g_previousX;
+        g_input.m_scrn_mov.dragY += ypos - g_previousY;
 
         // Update previous mouse position
         g_previousX = xpos;
@@ -720,9 +2477,22 @@ static void cursor_pos_callback(GLFWwindow* window, double xpos, double ypos) {
     return;
 }
 
+/**
+ * @brief Mouse wheel, zoom about the cursor, applied by update_camera()
+ */
+static void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
+{
+    g_input.m_scrn_mov.scroll += yoffset;
+    glfwGetCursorPos(window, &g_input.m_scrn_mov.scrollX, &g_input.m_scrn_mov.scrollY);
+    return;
+}
+
 
 /**
- * @brief Creates a texture with reduced resolution for sub-rendering purposes.
+ * @brief Creates an iteration buffer texture, with reduced resolution for sub-rendering purposes.
+ *
+ * RG32F, (escape iteration, |z|^2) per pixel, coloured by the colouring pass.
+ * Allocated in a power-of-two bucket, the render size is a viewport in it.
  *
  * @param[in] wd_  Width of window
  * @param[in] ht_  Height of window
@@ -732,14 +2502,13 @@ static void cursor_pos_callback(GLFWwindow* window, double xpos, double ypos) {
 void create_subres_texture( const int wd_, const int ht_, const int factor_, GLuint &rout_texture_)
 {
     glGenTextures(1, &rout_texture_);
-    glBindTexture(GL_TEXTURE_2D, rout_texture_);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
-        wd_ / factor_, ht_ / factor_,
-        0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    resize_iter_texture(rout_texture_, texture_bucket(wd_ / factor_), texture_bucket(ht_ / factor_));
 
-    // set filter and wrap
+    // set filter and wrap, 
+    // Note: no filtering, iteration counts do not interpolate across the set's boundary
+    glBindTexture(GL_TEXTURE_2D, rout_texture_);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST); // texture to larger
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); // texture to smaller
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST); // texture to smaller
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glBindTexture(GL_TEXTURE_2D, 0);
@@ -747,7 +2516,170 @@ void create_subres_texture( const int wd_, const int ht_, const int factor_, GLu
     return;
 }
 
+/**
+ * @brief (Re)allocates an iteration buffer texture.
+ *
+ * @param[in] texture_  texture ID
+ * @param[in] wd_, ht_  size in pixels
+ */
+void resize_iter_texture(GLuint texture_, const int wd_, const int ht_)
+{
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32F,
+        wd_, ht_,
+        0, GL_RG, GL_FLOAT, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return;
+}
+
+
+
+/**
+ * @brief (Re)allocates the edge mask and the accumulation buffers of the supersampling.
+ *
+ * @param[in] wd_, ht_  size in pixels
+ */
+void resize_ssaa_textures(const int wd_, const int ht_)
+{
+    glBindTexture(GL_TEXTURE_2D, g_edge_mask);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, wd_, ht_, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+    glBindTexture(GL_TEXTURE_2D, g_accum_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, wd_, ht_, 0, GL_RGBA, GL_FLOAT, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+    glBindTexture(GL_TEXTURE_2D, g_moment_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, wd_, ht_, 0, GL_RED, GL_FLOAT, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return;
+}
+
+/**
+ * @brief Apply a settled window size to the render textures.
+ *
+ * The textures are allocated in power-of-two buckets, the render size is a
+ * viewport in them, (see texture_scale()), they are only reallocated when
+ * the size leaves its bucket.
+ *
+ * @param[in] wd_, ht_  new render size, in pixels
+ */
+void resize_render_textures(const int wd_, const int ht_)
+{
+    if (texture_bucket(wd_) != texture_bucket(g_scrn_wd) || texture_bucket(ht_) != texture_bucket(g_scrn_ht)) {
+        int _wd = texture_bucket(wd_);
+        int _ht = texture_bucket(ht_);
+
+        resize_iter_texture(g_iter_texture, _wd, _ht);
+        resize_iter_texture(g_sample_texture, _wd, _ht);
+        resize_ssaa_textures(_wd, _ht);
+        resize_view_texture(g_view_texture, _wd, _ht);
+        resize_view_texture(g_reproj_texture, _wd, _ht);
+        resize_iter_texture(g_prefetch_iter, _wd, _ht);
+        resize_view_texture(g_prefetch_texture, _wd, _ht);
+        resize_history_textures(_wd, _ht);
+    }
+
+    if (texture_bucket(wd_ / SUB_RENDER_FACTOR) != texture_bucket(g_scrn_wd / SUB_RENDER_FACTOR)
+        || texture_bucket(ht_ / SUB_RENDER_FACTOR) != texture_bucket(g_scrn_ht / SUB_RENDER_FACTOR)) {
+
+        resize_iter_texture(g_mdb_texture,
+            texture_bucket(wd_ / SUB_RENDER_FACTOR),
+            texture_bucket(ht_ / SUB_RENDER_FACTOR));
+    }
+
+    if (texture_bucket(wd_ / CHECKER_FACTOR) != texture_bucket(g_scrn_wd / CHECKER_FACTOR)
+        || texture_bucket(ht_ / CHECKER_FACTOR) != texture_bucket(g_scrn_ht / CHECKER_FACTOR)) {
+
+        resize_iter_texture(g_checker_texture,
+            texture_bucket(wd_ / CHECKER_FACTOR),
+            texture_bucket(ht_ / CHECKER_FACTOR));
+        resize_view_texture(g_taa_sample_texture,
+            texture_bucket(wd_ / CHECKER_FACTOR),
+            texture_bucket(ht_ / CHECKER_FACTOR));
+    }
+
+    g_scrn_wd = wd_;
+    g_scrn_ht = ht_;
+
+    // the accumulated samples are gone, the view is rendered again at the new size
+    g_ssaa_sample = 0;
+    g_b_reproj = false;
+    g_b_history = false;
+    cancel_prefetch();
+    return;
+}
+
+/**
+ * @brief Allocated size of a render texture dimension, the next power of two.
+ *
+ * @param[in] px_  render size, in pixels
+ */
+auto texture_bucket(int px_)-> int
+{
+    return static_cast<int>(std::bit_ceil(static_cast<unsigned>(std::max(px_, 1))));
+}
+
+/**
+ * @brief Texture coordinate scale of the rendered part of a bucketed texture.
+ *
+ * @param[in] texture_  texture ID
+ * @param[in] wd_, ht_  rendered size, in pixels
+ * @return (wd_, ht_) / texture size
+ */
+auto texture_scale(GLuint texture_, int wd_, int ht_)-> glm::vec2
+{
+    // no binding, the texture units are left as they are
+    GLint _tex_wd, _tex_ht;
+    glGetTextureLevelParameteriv(texture_, 0, GL_TEXTURE_WIDTH, &_tex_wd);
+    glGetTextureLevelParameteriv(texture_, 0, GL_TEXTURE_HEIGHT, &_tex_ht);
+
+    return glm::vec2(float(wd_) / float(_tex_wd), float(ht_) / float(_tex_ht));
+}
+
+/**
+ * @brief (Re)allocates the view image, (or the reprojection one).
+ *
+ * @param[in] texture_  texture ID
+ * @param[in] wd_, ht_  size in pixels
+ */
+void resize_view_texture(GLuint texture_, const int wd_, const int ht_)
+{
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, wd_, ht_, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return;
+}
+
+/**
+ * @brief (Re)allocates the history textures of the temporal upscaling, 
+ * RGBA16F, linear filter.
+ *
+ * @param[in] wd_, ht_  size in pixels
+ */
+void resize_history_textures(const int wd_, const int ht_)
+{
+    for (GLuint _texture : g_history_texture) {
+        glBindTexture(GL_TEXTURE_2D, _texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, wd_, ht_, 0, GL_RGBA, GL_FLOAT, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
 
+    return;
+}
 
 /**
  * @brief Split a double value into two float representation
@@ -762,4 +2694,19 @@ void double_to_ds(double dval_, float& rout_val_, float& rout_err_)
     rout_err_ = (static_cast<float>(dval_ - rout_val_));
 
     return;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Split a double-double value into two float representation
+ *
+ * @param[in] ddval_  double-double value
+ * @param[out] rout_val_ Reference to store the value 'ddval_' in float type
+ * @param[out] rout_err_ Reference to store precision loss when value 'ddval_' is stored in float type
+ */
+void dd_to_ds(const deuxDouble& ddval_, float& rout_val_, float& rout_err_)
+{
+    rout_val_ = (static_cast<float>(ddval_.val));
+    rout_err_ = (static_cast<float>((ddval_.val - rout_val_) + ddval_.err));
+
+    return;
+}
@@ -0,0 +1,171 @@
+/**
+ * @brief Colouring pass, (and upsampling) of the iteration buffer.
+ *
+ *  The mandelbrot shader stores (escape iteration, |z|^2) per pixel, the
+ *  colour is looked up here, in a 1D palette texture (linear filter,
+ *  repeat wrap), one colour cycle per unit of palette coordinate.
+ *
+ *  With histogram equalisation, the palette coordinate is the CDF of the
+ *  escape iterations of the frame, (histogram.comp.glsl, histogram_cdf.comp.glsl),
+ *  interpolated in the bin by the smooth iteration count, as equalised_coord().
+ *
+ *  Upsampling, (u_Upsample), blends the colours of the 4 nearest pixels of the
+ *  buffer, bilinear weights times a range weight on their smooth iteration
+ *  count against the nearest one, (joint bilateral): smooth bands are
+ *  interpolated, the set boundary and iteration steps stay sharp.
+ *
+ * @param texCoords, texture coordinates.
+ * @param u_IterTexture, iteration buffer, RG32F, (-1, 0) for bounded pixels.
+ * @param u_TexScale, size of the rendered part of the iteration buffer / its texture size.
+ * @param u_Palette, palette texture.
+ * @param u_Equalise, 1 for histogram equalisation.
+ * @param u_MaxIter, maximum number of iterations, of the histogram.
+ * @param u_Cdf, CDF of the iteration histogram.
+ * @param u_SampleMask, R8, with u_Masked, only the pixels set are coloured, (supersampling).
+ * @param u_Upsample, 1 if the iteration buffer is coarser than the target.
+ * @param u_SampleOffset, offset of the pixels of the buffer, in its pixels, (jitter of the temporal upscaling).
+ *
+ * @return FragColor, pixel color.
+ * @return LumaSquared, its squared luminance, (second moment of the supersampling).
+ */
+
+#version 450 core
+
+layout(location = 0) out vec4 FragColor;
+layout(location = 1) out float LumaSquared;
+in vec2 texCoords;
+
+uniform sampler2D u_IterTexture;
+uniform vec2 u_TexScale = vec2(1.0);
+uniform sampler1D u_Palette;
+
+uniform int u_Equalise = 0;
+uniform float u_MaxIter = 1000;
+
+#define HISTOGRAM_BINS 4096
+
+layout(std430, binding = 3) readonly buffer CdfBuffer {
+    float u_Cdf[HISTOGRAM_BINS];
+};
+
+uniform sampler2D u_SampleMask;
+uniform int u_Masked = 0;
+
+uniform int u_Upsample = 0;
+uniform vec2 u_SampleOffset = vec2(0.0);
+
+#define TWO_PI 6.28318530718
+
+// range of the upsampling weights, smooth iterations
+#define UPSAMPLE_SIGMA 1.5
+
+/**
+ * @brief Equalised palette coordinate, in [0, 1]
+ */
+float equalised_coord(float iter_, float dist2_)
+{
+    float _frac = clamp(2.0 - log2(log2(dist2_)), 0.0, 0.999);
+
+    int _max_iter = int(u_MaxIter);
+    int _k = min(int(double(int(iter_)) * HISTOGRAM_BINS / double(_max_iter)), HISTOGRAM_BINS - 1);
+
+    // position in the bin, a bin is one iteration, or (max_iter / HISTOGRAM_BINS) of them
+    float _w = (_max_iter <= HISTOGRAM_BINS)
+        ? _frac
+        : clamp((iter_ + _frac) * HISTOGRAM_BINS / u_MaxIter - float(_k), 0.0, 1.0);
+
+    float _c0 = (_k > 0) ? u_Cdf[_k - 1] : 0.0;
+    float _c1 = u_Cdf[_k];
+
+    return _c0 + (_c1 - _c0) * _w;
+}
+
+/**
+ * @brief Colour of an iteration buffer pixel, black if bounded
+ */
+vec3 pixel_colour(vec2 r_)
+{
+    if (r_.x < 0.0) {
+        return vec3(0.0);
+    }
+
+    float _t;
+
+    if (u_Equalise != 0) {
+        _t = equalised_coord(r_.x, r_.y);
+    }
+    else {
+        // smooth iteration count, same colour cycle as the former colorFunc2(),
+        // 0.5 + 0.5 * cos(2.7 + sl * 30.0 + offset)
+        float sl = (r_.x - log2(log2(r_.y)) + 4.0) * .0025;
+        _t = (2.7 + sl * 30.0) / TWO_PI;
+    }
+
+    return texture(u_Palette, _t).rgb;
+}
+
+/**
+ * @brief Smooth iteration count of an escaped pixel
+ */
+float smooth_iter(vec2 r_)
+{
+    return r_.x + 1.0 - log2(log2(r_.y));
+}
+
+/**
+ * @brief Edge-aware upsampled colour, joint bilateral over the 4 nearest pixels
+ */
+vec3 upsampled_colour()
+{
+    ivec2 _size = ivec2(vec2(textureSize(u_IterTexture, 0)) * u_TexScale + 0.5);
+    vec2 _p = texCoords * vec2(_size) - 0.5 - u_SampleOffset;
+    ivec2 _i0 = ivec2(floor(_p));
+    vec2 _f = _p - floor(_p);
+
+    // the nearest pixel is the reference of the range weights
+    ivec2 _n = clamp(_i0 + ivec2(step(0.5, _f)), ivec2(0), _size - 1);
+    vec2 _rn = texelFetch(u_IterTexture, _n, 0).xy;
+    float _sn = smooth_iter(_rn);
+
+    vec3 _sum = vec3(0.0);
+    float _wsum = 0.0;
+
+    for (int _j = 0; _j < 2; ++_j) {
+        for (int _i = 0; _i < 2; ++_i) {
+            ivec2 _q = clamp(_i0 + ivec2(_i, _j), ivec2(0), _size - 1);
+            vec2 _r = texelFetch(u_IterTexture, _q, 0).xy;
+            float _s = smooth_iter(_r);
+
+            // bounded and escaped pixels never blend
+            if ((_r.x < 0.0) != (_rn.x < 0.0)) {
+                continue;
+            }
+            float _ds = (_r.x < 0.0) ? 0.0 : (_s - _sn) / UPSAMPLE_SIGMA;
+            float _w = (_i == 1 ? _f.x : 1.0 - _f.x) * (_j == 1 ? _f.y : 1.0 - _f.y) * exp(-0.5 * _ds * _ds);
+
+            _sum += _w * pixel_colour(_r);
+            _wsum += _w;
+        }
+    }
+
+    // the nearest pixel has a bilinear weight of at least 1/4, and a range weight of 1
+    return _sum / _wsum;
+}
+
+void main()
+{
+    if (u_Masked != 0 && texelFetch(u_SampleMask, ivec2(gl_FragCoord.xy), 0).r == 0.0) {
+        discard;
+    }
+
+    if (u_Upsample != 0) {
+        FragColor = vec4(upsampled_colour(), 1.0);
+    }
+    else {
+        FragColor = vec4(pixel_colour(texture(u_IterTexture, texCoords * u_TexScale).xy), 1.0);
+    }
+
+    float _luma = dot(FragColor.rgb, vec3(0.2126, 0.7152, 0.0722));
+    LumaSquared = _luma * _luma;
+    return;
+}
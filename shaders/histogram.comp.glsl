@@ -0,0 +1,73 @@
+/**
+ * @brief Compute shader, histogram of the escape iterations of an iteration buffer.
+ *
+ *  A work group counts a 32x32 block of pixels (2x2 per invocation) in a
+ *  shared histogram, then adds its non-empty bins to the global one, so
+ *  the global atomics do not pile up on the few bins of a deep zoom.
+ *  The global histogram is cleared by the host before the dispatch.
+ *
+ * @param u_IterImage, iteration buffer, RG32F, (-1, 0) for bounded pixels.
+ * @param u_Size, size of the rendered part of the iteration buffer.
+ * @param u_MaxIter, maximum number of iterations, the bins span [0, u_MaxIter).
+ * @param u_Histogram, HISTOGRAM_BINS counts, same binning as histogram_bin().
+ */
+
+#version 450 core
+
+#define HISTOGRAM_BINS 4096
+#define GROUP_SIZE 16
+
+layout(local_size_x = GROUP_SIZE, local_size_y = GROUP_SIZE) in;
+
+layout(rg32f, binding = 0) readonly uniform image2D u_IterImage;
+
+layout(std430, binding = 2) buffer HistogramBuffer {
+    uint u_Histogram[HISTOGRAM_BINS];
+};
+
+uniform ivec2 u_Size;
+uniform float u_MaxIter = 1000;
+
+shared uint s_histogram[HISTOGRAM_BINS];
+
+void main()
+{
+    const uint _n_local = GROUP_SIZE * GROUP_SIZE;
+    const uint _local = gl_LocalInvocationIndex;
+
+    for (uint _b = _local; _b < HISTOGRAM_BINS; _b += _n_local) {
+        s_histogram[_b] = 0u;
+    }
+    barrier();
+
+    ivec2 _size = u_Size;
+    ivec2 _base = ivec2(gl_WorkGroupID.xy) * (2 * GROUP_SIZE) + ivec2(gl_LocalInvocationID.xy);
+    int _max_iter = int(u_MaxIter);
+
+    for (int _dy = 0; _dy < 2; ++_dy) {
+        for (int _dx = 0; _dx < 2; ++_dx) {
+            ivec2 _p = _base + GROUP_SIZE * ivec2(_dx, _dy);
+            if (any(greaterThanEqual(_p, _size))) {
+                continue;
+            }
+
+            float _iter = imageLoad(u_IterImage, _p).x;
+            if (_iter < 0.0) {
+                continue;
+            }
+
+            // exact as the 64-bit histogram_bin(), int(_iter) * HISTOGRAM_BINS overflows an int
+            int _bin = min(int(double(int(_iter)) * HISTOGRAM_BINS / double(_max_iter)), HISTOGRAM_BINS - 1);
+            atomicAdd(s_histogram[_bin], 1u);
+        }
+    }
+    barrier();
+
+    for (uint _b = _local; _b < HISTOGRAM_BINS; _b += _n_local) {
+        uint _count = s_histogram[_b];
+        if (_count != 0u) {
+            atomicAdd(u_Histogram[_b], _count);
+        }
+    }
+    return;
+}
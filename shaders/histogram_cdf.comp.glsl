@@ -0,0 +1,60 @@
+/**
+ * @brief Compute shader, CDF of the iteration histogram, a prefix sum in one work group.
+ *
+ *  Each invocation sums its HISTOGRAM_BINS / SCAN_SIZE consecutive bins,
+ *  the sums are scanned in shared memory (Hillis-Steele), then each
+ *  invocation writes the inclusive prefix of its own bins, normalised.
+ *  Same result as build_cdf().
+ *
+ * @param u_Histogram, HISTOGRAM_BINS counts.
+ * @param u_Cdf, HISTOGRAM_BINS, (count of bins 0..k) / total, 0 if empty.
+ */
+
+#version 450 core
+
+#define HISTOGRAM_BINS 4096
+#define SCAN_SIZE 1024
+#define BINS_PER_INVOCATION (HISTOGRAM_BINS / SCAN_SIZE)
+
+layout(local_size_x = SCAN_SIZE) in;
+
+layout(std430, binding = 2) readonly buffer HistogramBuffer {
+    uint u_Histogram[HISTOGRAM_BINS];
+};
+
+layout(std430, binding = 3) writeonly buffer CdfBuffer {
+    float u_Cdf[HISTOGRAM_BINS];
+};
+
+shared uint s_scan[SCAN_SIZE];
+
+void main()
+{
+    const uint _t = gl_LocalInvocationIndex;
+    const uint _first = _t * BINS_PER_INVOCATION;
+
+    uint _sum = 0u;
+    for (uint _i = 0u; _i < BINS_PER_INVOCATION; ++_i) {
+        _sum += u_Histogram[_first + _i];
+    }
+    s_scan[_t] = _sum;
+    barrier();
+
+    // inclusive scan of the sums
+    for (uint _d = 1u; _d < SCAN_SIZE; _d <<= 1) {
+        uint _v = (_t >= _d) ? s_scan[_t - _d] : 0u;
+        barrier();
+        s_scan[_t] += _v;
+        barrier();
+    }
+
+    uint _total = s_scan[SCAN_SIZE - 1];
+    float _norm = (_total > 0u) ? 1.0 / float(_total) : 0.0;
+
+    uint _run = s_scan[_t] - _sum;
+    for (uint _i = 0u; _i < BINS_PER_INVOCATION; ++_i) {
+        _run += u_Histogram[_first + _i];
+        u_Cdf[_first + _i] = float(_run) * _norm;
+    }
+    return;
+}
@@ -0,0 +1,51 @@
+/**
+ * @brief Fragment shader for the Julia set thumbnail atlas.
+ *
+ *  Same iteration as render_01_std() of the mandelbrot shader, in Julia
+ *  mode, over [-2, 2]^2. Writes the iteration atlas, coloured by the
+ *  colouring pass, (colour_shader.fs.glsl), as the view.
+ *
+ * @param planePos, position in the thumbnail, [-1, 1].
+ * @param juliaC, Julia constant of the thumbnail.
+ * @param u_MaxIter, maximum number of iterations.
+ *
+ * @return myOutputIter, (escape iteration, |z|^2), (-1, 0) if bounded.
+ */
+
+#version 450 core
+
+out vec2 myOutputIter;
+in vec2 planePos;
+flat in vec2 juliaC;
+
+uniform float u_MaxIter = 1000;
+
+void main()
+{
+    vec2 _result = vec2(-1.0, 0.0);
+
+    vec2 c = juliaC;
+    vec2 z = 2.0 * planePos;
+
+    int _iter = 0;
+
+    // hadamard product z o z
+    vec2 _zoz = vec2(z.x * z.x, z.y * z.y);
+
+    while (_iter < u_MaxIter) {
+        float _dist = _zoz.x + _zoz.y;
+
+        if (_dist > 4.0) {
+            _result = vec2(float(_iter), _dist);
+            break;
+        }
+
+        z.y = 2 * (z.x * z.y) + c.y;
+        z.x = (_zoz.x - _zoz.y) + c.x;
+        _zoz = vec2(z.x * z.x, z.y * z.y);
+        ++_iter;
+    }
+
+    myOutputIter = _result;
+    return;
+}
@@ -0,0 +1,35 @@
+/**
+ * @brief Vertex shader for the Julia set thumbnail atlas, instanced.
+ *
+ *  One instance per thumbnail, the quad is placed in the instance's slot
+ *  of the atlas.
+ *
+ * @param aPos, vertex position attribute, [-1, 1].
+ * @param aCell, per-instance attribute, (c.x, c.y, slot, -).
+ * @param u_AtlasSlots, number of slots per row, and of rows, of the atlas.
+ * @return planePos, position in the thumbnail, [-1, 1].
+ * @return juliaC, Julia constant of the thumbnail.
+ */
+
+#version 450 core
+
+layout(location = 0) in vec2 aPos;
+layout(location = 1) in vec4 aCell;
+
+uniform vec2 u_AtlasSlots;
+
+out vec2 planePos;
+flat out vec2 juliaC;
+
+void main() {
+    float _slot = aCell.z;
+    vec2 _cell = vec2(mod(_slot, u_AtlasSlots.x), floor(_slot / u_AtlasSlots.x));
+
+    // [-1, 1] of the slot, in [-1, 1] of the atlas
+    vec2 _pos = (_cell + (aPos + 1.0) * 0.5) / u_AtlasSlots * 2.0 - 1.0;
+
+    planePos = aPos;
+    juliaC = aCell.xy;
+    gl_Position = vec4(_pos, 0.0, 1.0);
+    return;
+}
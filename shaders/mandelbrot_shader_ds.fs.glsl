@@ -2,18 +2,27 @@
  * @brief Fragment shader for rendering Mandelbrot
  * 
  *  Emulated double precision is used in calculation.
- *  Mode 0 = double-float
- *  Mode 1 = double-double
+ *  Mode 0 = single float
+ *  Mode 1 = double-float
+ *  Mode 2 = double-double
+ *  Mode 3 = perturbation, against a reference orbit computed on the host
  *
  * @param planePos, The 2D plane position attribute forwarded from the vertex shader.
  * @param u_MandelbrotMode, Flag to determine whether to render the Mandelbrot or Juliabrot set.
- * @param u_Mode, rendering precision mode [0,1,2]. 
+ * @param u_ds_JuliaX, Julia constant, real part in double-float precision.
+ * @param u_ds_JuliaY, Julia constant, imaginary part in double-float precision.
+ * @param u_Mode, rendering precision mode [0,1,2,3]. 
  * @param u_ds_CameraPosX, camera x-position in double-float precision.
  * @param u_ds_CameraPosY, camera y-position in double-float precision.
  * @param u_CameraZoom, zoom level of the camera, (0., 1.]
+ * @param u_fe_CameraZoom, zoom level of the camera, float mantissa + int exponent.
  * @param u_MaxIter, maximum number of iterations for the Mandelbrot algorithm.
+ * @param u_RefOrbitLen, number of points in the reference orbit buffer.
+ * @param u_BlaLevels, number of levels in the BLA table buffer, 0 = no BLA.
+ * @param u_SampleMask, R8, with u_Masked, only the pixels set are rendered, (supersampling).
  * 
- * @return myOutputColor, pixel color in the Mandelbrot set.
+ * @return myOutputIter, (escape iteration, |z|^2 at escape), (-1, 0) if bounded,
+ *  coloured by the colouring pass.
  */
 
 #version 450 core
@@ -30,12 +39,16 @@
 precision highp float;
 #endif
 
-out vec4 myOutputColor;
+out vec2 myOutputIter;
 in vec2 planePos;
 
 uniform int u_MandelbrotMode = 1; // = 0 if we want to render Juliabrot
 uniform int u_Mode = 0;
 
+// Julia constant c, z starts at the pixel
+uniform vec2 u_ds_JuliaX = { 0., 0.};
+uniform vec2 u_ds_JuliaY = { 0., 0.};
+
 uniform vec2 u_ds_CameraPosX  = { 0., 0.};
 uniform vec2 u_ds_CameraPosY  = { 0., 0.};
 
@@ -45,18 +58,44 @@ uniform vec2 u_ds_CameraPosY  = { 0., 0.};
 
 uniform float u_CameraZoom = 1.0f;
 uniform float u_MaxIter = MAX_ITERATIONS;
- 
-
-/**
- * @brief color by Renormalizing the Mandelbrot Escape
- *
- */
-vec3 colorFunc2(int iter, float dist2) 
-{
-    float sl = (float(iter) - log2(log2(dist2)) + 4.0) * .0025;
-    return vec3(0.5 + 0.5 * cos(2.7 + sl * 30.0 + vec3(0.0, .6, 1.0)));
 
-} 
+// Extended-exponent float, value = m * 2^e.
+// float alone underflows at 1e-38, deep zoom scales go far beyond.
+struct floatexp {
+    float m;
+    int   e;
+};
+
+// Below 2^FE_RESCALE_EXP the perturbation deltas are iterated rescaled.
+#define FE_RESCALE_EXP -100
+
+uniform floatexp u_fe_CameraZoom;
+
+// Reference orbit Z_0 .. Z_n, rounded to double on the host
+layout(std430, binding = 0) readonly buffer RefOrbitBuffer {
+    dvec2 u_RefOrbit[];
+};
+uniform int u_RefOrbitLen = 0;
+
+// BLA table, built on the host from the reference orbit, level by level.
+// A step of level l skips 2^l iterations, dz' = A*dz + B*dc, while |dz| < r
+struct BlaStep {
+    vec2  A;
+    vec2  B;
+    float r;
+};
+
+layout(std430, binding = 1) readonly buffer BlaBuffer {
+    BlaStep u_Bla[];
+};
+uniform int u_BlaLevels = 0;
+uniform int u_BlaOffset[32]; // first entry of each level
+uniform int u_BlaCount[32];  // number of entries of each level
+
+// edge mask of the supersampling, the other pixels are discarded
+uniform sampler2D u_SampleMask;
+uniform int u_Masked = 0;
+ 
 
 /////////////////////////////////////
 
@@ -196,8 +235,9 @@ float2 emdp_mul( const float2 ds0_, const float2 ds1_)
  */
 double2 emdp_mul(const double2 ds0_, const double2 ds1_)
 { 
-    precise double cona = ds0_.x * 8193.f;
-    precise double conb = ds1_.x * 8193.f;
+    // split constant for double, 2^27 + 1, (8193 = 2^13 + 1 only splits a float)
+    precise double cona = ds0_.x * 134217729.0lf;
+    precise double conb = ds1_.x * 134217729.0lf;
     precise double a1 = cona - (cona - ds0_.x); // hi-split
     precise double b1 = conb - (conb - ds1_.x); // hi-split
 
@@ -270,8 +310,8 @@ float2 emdp_scale( const float2 ds0_, const float sc_)
  */
 double2 emdp_scale(const double2 ds0_, const float sc_)
 {
-    precise double cona = ds0_.x * 8193.;
-    precise double conb = sc_ * 8193.;
+    precise double cona = ds0_.x * 134217729.0lf;
+    precise double conb = sc_ * 8193.; // sc_ is a float
 
     double a1 = cona - (cona - ds0_.x); // hi-split
     double b1 = conb - (conb - sc_);    // hi-split
@@ -300,13 +340,62 @@ double2 emdp_scale(const double2 ds0_, const float sc_)
 
 /////////////////////////////////////
 
+/**
+ * @brief complex multiplication
+ *
+ */
+vec2 cmul(const vec2 a_, const vec2 b_)
+{
+    return vec2(a_.x * b_.x - a_.y * b_.y, a_.x * b_.y + a_.y * b_.x);
+}
+
+/**
+ * @brief Longest valid BLA step starting at orbit index n_.
+ *
+ *  |dz|^2 is given as (dz_norm2_ * 2^(2 * dz_exp_)), for rescaled deltas.
+ *  Level 0 costs the same as a normal step, so is never used.
+ *
+ * @return index into u_Bla, -1 if none is valid. len_, iterations skipped.
+ */
+int bla_lookup(int n_, float dz_norm2_, int dz_exp_, int max_len_, out int len_)
+{
+    len_ = 0;
+    if (n_ <= 0) {
+        return -1;
+    }
+
+    // an entry of level l starts at multiples of 2^l
+    for (int _level = min(findLSB(n_), u_BlaLevels - 1); _level > 0; --_level) {
+        int _len = 1 << _level;
+        int _i = n_ >> _level;
+
+        if (_len > max_len_ || _i >= u_BlaCount[_level]) {
+            continue;
+        }
+
+        int _k = u_BlaOffset[_level] + _i;
+        float _r = u_Bla[_k].r;
+
+        // |dz| < r, in the scale of dz
+        int _re;
+        float _rm = frexp(_r, _re);
+        int _d = _re - dz_exp_;
+
+        if (_r > 0.0 && (_d > 64 || (_d > -64 && dz_norm2_ < (_rm * _rm) * exp2(float(2 * _d))))) {
+            len_ = _len;
+            return _k;
+        }
+    }
+    return -1;
+}
+
 /**
  * @brief
  *
  */
 void render_01_ds()
 {
-    vec3 color = vec3(0.0, 0.0, 0.0);
+    vec2 _result = vec2(-1.0, 0.0);
 
     float2 _t1x = float2( planePos.x*2, 0.f );
     float2 _t1y = float2( planePos.y*2, 0.f );
@@ -321,17 +410,14 @@ void render_01_ds()
     // vec2 z = c;
     // We could have set _ds_zx and _ds_zy to zero for strict adherence to the
     // numerical algorithm, but that's just one iteration step ahead. And
-    // i just want to make it easier to turn this into a juliabrot renderer.
-    // Note: juliabrot code is not in the render_01_dd(), yet.
+    // it makes this a juliabrot renderer by only replacing c.
     float2 _ds_zx =  _ds_cx;
     float2 _ds_zy =  _ds_cy;
     
-    //-- if you want Juliabrot, just uncomment one of these sets
-    //_ds_cx = float2( 0.28, 0.);  // julia set 1
-    //_ds_cy = float2( 0.008, 0.); // julia set 1
-
-    //_ds_cx = float2( -0.70176, 0.); // julia set 2
-    //_ds_cy = float2(0.3842, 0.);  // julia set 2
+    if (u_MandelbrotMode == 0) {
+        _ds_cx = u_ds_JuliaX;
+        _ds_cy = u_ds_JuliaY;
+    }
 
     int iterations = 0;
 
@@ -343,7 +429,7 @@ void render_01_ds()
         float2 _dist0 = emdp_add(_ds_dist_x, _ds_dist_y);
 
         if (_dist0.x > 4.0) {
-            color = colorFunc2(iterations, float(_dist0.x) );
+            _result = vec2(float(iterations), float(_dist0.x));
             break;
         }
 
@@ -359,7 +445,7 @@ void render_01_ds()
 
         ++iterations;
     }
-    myOutputColor = vec4(color, 1.0);
+    myOutputIter = _result;
     return;
 }
 
@@ -369,7 +455,7 @@ void render_01_ds()
  */
 void render_01_dd()
 {
-    vec3 color = vec3(0.0, 0.0, 0.0);
+    vec2 _result = vec2(-1.0, 0.0);
 
     double2 _t1x = double2(planePos.x * 2, 0.f);
     double2 _t1y = double2(planePos.y * 2, 0.f);
@@ -383,6 +469,11 @@ void render_01_dd()
     double2 _ds_zx = _ds_cx;
     double2 _ds_zy = _ds_cy;
 
+    if (u_MandelbrotMode == 0) {
+        _ds_cx = double2(u_ds_JuliaX);
+        _ds_cy = double2(u_ds_JuliaY);
+    }
+
     int iterations = 0;
 
     double2 _ds_dist_x = emdp_mul(_ds_zx, _ds_zx);
@@ -393,7 +484,7 @@ void render_01_dd()
         double2 _dist0 = emdp_add(_ds_dist_x, _ds_dist_y);
 
         if (_dist0.x > 4.0) {
-            color = colorFunc2(iterations, float(_dist0.x));
+            _result = vec2(float(iterations), float(_dist0.x));
             break;
         }
 
@@ -410,7 +501,7 @@ void render_01_dd()
         ++iterations;
     }
 
-    myOutputColor = vec4(color, 1.0);
+    myOutputIter = _result;
     return;
 }
 
@@ -420,12 +511,16 @@ void render_01_dd()
  */
 void render_01_std()
 {
-    vec3 _color = vec3(0.0, 0.0, 0.0);
+    vec2 _result = vec2(-1.0, 0.0);
 
     vec2 _camPos = vec2(u_ds_CameraPosX.x, u_ds_CameraPosY.x);
     vec2 c = (2.0 * u_CameraZoom) * planePos + _camPos;
     vec2 z = c;
 
+    if (u_MandelbrotMode == 0) {
+        c = vec2(u_ds_JuliaX.x, u_ds_JuliaY.x);
+    }
+
     int _iter = 0;
     //-- original version, non-optimize
     /* {
@@ -437,8 +532,8 @@ void render_01_std()
             // compute |_new_z|^{2}
             float _dist = dot(_new_z, _new_z);
             if (_dist > 4.0) {
-                // if |_new_z|^{2} > 2^{2}, abort and _color
-                _color = _colorFunc2(_iter, _dist);
+                // if |_new_z|^{2} > 2^{2}, abort and keep the result
+                _result = vec2(float(_iter), _dist);
                 break;
             }
             // assigning for the next iteration
@@ -458,8 +553,8 @@ void render_01_std()
         float _dist = _zoz.x + _zoz.y;
 
         if( _dist > 4.0) {
-            // if |z|^{2} > 2^{2}, abort and color
-            _color = colorFunc2( _iter, _dist);
+            // if |z|^{2} > 2^{2}, abort and keep the result
+            _result = vec2(float(_iter), _dist);
             break;
         }
 
@@ -474,8 +569,150 @@ void render_01_std()
         ++_iter;
     }
 
-    myOutputColor = vec4( _color, 1.0);
+    myOutputIter = _result;
+
+    return;
+}
+
+
+/**
+ * @brief Perturbation, iterate the pixel's delta dz against the reference orbit Z.
+ *
+ *  dz' = 2*Z*dz + dz^2 + dc
+ * 
+ *  While the deltas are below float range, they are iterated rescaled,
+ *  dz = w * 2^e, with w kept near unit magnitude:
+ *  w' = 2*Z*w + 2^e * w^2 + dc / 2^e
+ *
+ *  Glitches (the pixel orbit losing track of the reference) are avoided 
+ *  by rebasing: once |z| < |dz|, z itself becomes the delta against Z_0 = 0,
+ *  so a single reference orbit serves the whole frame.
+ */
+void render_01_pt()
+{
+    vec2 _result = vec2(-1.0, 0.0);
+
+    int _iter = 0;
+    int _n = 0; // index into the reference orbit
+    int _last = u_RefOrbitLen - 1;
+
+    vec2 _dz = vec2(0.0);
+    vec2 _dc = vec2(0.0);
+
+    if (u_fe_CameraZoom.e < FE_RESCALE_EXP) {
+        vec2 _dcw = (2.0 * u_fe_CameraZoom.m) * planePos;
+        int  _dce = u_fe_CameraZoom.e;
+
+        vec2 _w = vec2(0.0);
+        int  _e = _dce;
+
+        while (_iter < u_MaxIter) {
+            vec2 _Z = vec2(u_RefOrbit[_n]);
+
+            int _len;
+            int _bla = bla_lookup(_n, dot(_w, _w), _e, int(u_MaxIter) - _iter, _len);
+
+            if (_bla >= 0) {
+                // skip _len iterations, w' = A*w + B*dc / 2^e
+                _w = cmul(u_Bla[_bla].A, _w) + cmul(u_Bla[_bla].B, ldexp(_dcw, ivec2(_dce - _e)));
+                _n += _len;
+                _iter += _len - 1;
+            }
+            else {
+                vec2 _w2 = vec2(_w.x * _w.x - _w.y * _w.y, 2.0 * _w.x * _w.y);
+
+                _w = 2.0 * vec2(_Z.x * _w.x - _Z.y * _w.y, _Z.x * _w.y + _Z.y * _w.x)
+                    + ldexp(_w2, ivec2(_e))
+                    + ldexp(_dcw, ivec2(_dce - _e));
+                ++_n;
+            }
+
+            // renormalise w
+            float _m = max(abs(_w.x), abs(_w.y));
+            if (_m != 0.0 && (_m > 65536.0 || _m < 1.0 / 65536.0)) {
+                int _k;
+                frexp(_m, _k);
+                _w = ldexp(_w, ivec2(-_k));
+                _e += _k;
+            }
+
+            _Z = vec2(u_RefOrbit[_n]);
+            vec2 _z = _Z + ldexp(_w, ivec2(_e));
+            float _dist = dot(_z, _z);
+
+            if (_dist > 4.0) {
+                myOutputIter = vec2(float(_iter), _dist);
+                return;
+            }
+
+            ++_iter;
+
+            if (_n == _last) {
+                // end of an escaped reference, z is now the delta to Z_0 = 0
+                _dz = _z;
+                _n = 0;
+                break;
+            }
+
+            // rebase, |z| < |dz| only when Z is as tiny as dz, 
+            // compared in units of 2^e, as both underflow float
+            if (dot(_Z, _Z) < 1e-30) {
+                vec2 _zw = vec2(ldexp(u_RefOrbit[_n], ivec2(-_e))) + _w;
+                if (dot(_zw, _zw) < dot(_w, _w)) {
+                    _w = _zw;
+                    _n = 0;
+                }
+            }
+
+            if (_e > FE_RESCALE_EXP) {
+                // deltas are in float range again
+                _dz = ldexp(_w, ivec2(_e));
+                break;
+            }
+        }
+        _dc = ldexp(_dcw, ivec2(_dce));
+    }
+    else {
+        _dc = (2.0 * ldexp(u_fe_CameraZoom.m, u_fe_CameraZoom.e)) * planePos;
+    }
+
+    while (_iter < u_MaxIter) {
+        vec2 _Z = vec2(u_RefOrbit[_n]);
+
+        int _len;
+        int _bla = bla_lookup(_n, dot(_dz, _dz), 0, int(u_MaxIter) - _iter, _len);
 
+        if (_bla >= 0) {
+            // skip _len iterations, dz' = A*dz + B*dc
+            _dz = cmul(u_Bla[_bla].A, _dz) + cmul(u_Bla[_bla].B, _dc);
+            _n += _len;
+            _iter += _len - 1;
+        }
+        else {
+            _dz = vec2(
+                2.0 * (_Z.x * _dz.x - _Z.y * _dz.y) + (_dz.x * _dz.x - _dz.y * _dz.y),
+                2.0 * (_Z.x * _dz.y + _Z.y * _dz.x) + (2.0 * _dz.x * _dz.y)) + _dc;
+            ++_n;
+        }
+
+        vec2 _z = vec2(u_RefOrbit[_n]) + _dz;
+        float _dist = dot(_z, _z);
+
+        if (_dist > 4.0) {
+            _result = vec2(float(_iter), _dist);
+            break;
+        }
+
+        if (_n == _last || _dist < dot(_dz, _dz)) {
+            // rebase, (or end of an escaped reference)
+            // z is now the delta to Z_0 = 0
+            _dz = _z;
+            _n = 0;
+        }
+        ++_iter;
+    }
+
+    myOutputIter = _result;
     return;
 }
 
@@ -484,6 +721,10 @@ void render_01_std()
 
 void main()
 {
+    if (u_Masked != 0 && texelFetch(u_SampleMask, ivec2(gl_FragCoord.xy), 0).r == 0.0) {
+        discard;
+    }
+
     if (u_Mode == 0) {
         // standard 32bit mode, 
         // artifacts will appear aroung zoom scale 1e+7
@@ -493,10 +734,20 @@ void main()
         // emulated 2x 32bit mode
         render_01_ds();
     }
-    else {
+    else if (u_Mode == 2) {
         // emulated 2x 64bit mode.
         render_01_dd();
     }
+    else if (u_MandelbrotMode == 0) {
+        // the reference orbit is a Mandelbrot orbit, 
+        // Julia sets go no deeper than double-double
+        render_01_dd();
+    }
+    else {
+        // perturbation against the reference orbit, 
+        // zoom depth limited only by the floatexp range
+        render_01_pt();
+    }
  
     return;
 }
\ No newline at end of file
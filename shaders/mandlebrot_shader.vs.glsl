@@ -2,6 +2,7 @@
  * @brief Vertex shader for rendering Mandelbrot
  *
  * @param pos,  vertex position attribute. 
+ * @param u_Jitter, sub-pixel offset of the sample, in plane units, (supersampling).
  * @return planePos, 2d plane position forwarded to the fragment shader.
  */
 
@@ -10,6 +11,8 @@
 out vec2 planePos;                  // Output 2d plane position
 layout (location = 0) in vec2 aPos; // incoming vertex position attribute
 
+uniform vec2 u_Jitter = vec2(0.);
+
 void main()
 {
     // Set current vertex position
@@ -17,7 +20,7 @@ void main()
     gl_Position = vec4(aPos.xy, 0.,1.);
 
     // foward position to the fragment shader
-    planePos = aPos;
+    planePos = aPos + u_Jitter;
 
     return;
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+/**
+ * @brief Compute shader, convergence test of the supersampling, after each sample.
+ *
+ *  A pixel of the edge mask is done once it has u_MinSamples, and the
+ *  standard error of the mean of its luminance is below u_Tolerance, it is
+ *  then cleared from the mask, (no more samples). The pixels left are counted.
+ *
+ * @param u_AccumImage, RGBA32F, (sum of the sample colours, number of samples).
+ * @param u_MomentImage, R32F, sum of the squared sample luminances.
+ * @param u_EdgeMask, R8, the pixels still sampled.
+ * @param u_Size, size of the rendered part of the buffers.
+ * @param u_MinSamples, samples before a pixel may be done.
+ * @param u_Tolerance, standard error of the mean luminance, in [0, 1].
+ * @param u_Active, count of the pixels still sampled, cleared by the host.
+ */
+
+#version 450 core
+
+layout(local_size_x = 16, local_size_y = 16) in;
+
+layout(rgba32f, binding = 0) readonly uniform image2D u_AccumImage;
+layout(r32f, binding = 1) readonly uniform image2D u_MomentImage;
+layout(r8, binding = 2) uniform image2D u_EdgeMask;
+
+layout(std430, binding = 4) buffer ActiveBuffer {
+    uint u_Active;
+};
+
+uniform ivec2 u_Size;
+uniform float u_MinSamples = 4.0;
+uniform float u_Tolerance = 0.002;
+
+void main()
+{
+    ivec2 _p = ivec2(gl_GlobalInvocationID.xy);
+    if (any(greaterThanEqual(_p, u_Size))) {
+        return;
+    }
+    if (imageLoad(u_EdgeMask, _p).r == 0.0) {
+        return;
+    }
+
+    vec4 _acc = imageLoad(u_AccumImage, _p);
+    float _n = _acc.a;
+
+    if (_n >= u_MinSamples) {
+        float _mean = dot(_acc.rgb, vec3(0.2126, 0.7152, 0.0722)) / _n;
+        float _var = max(imageLoad(u_MomentImage, _p).r / _n - _mean * _mean, 0.0);
+
+        // variance of the mean
+        if (_var / _n < u_Tolerance * u_Tolerance) {
+            imageStore(u_EdgeMask, _p, vec4(0.0));
+            return;
+        }
+    }
+
+    atomicAdd(u_Active, 1u);
+    return;
+}
@@ -0,0 +1,75 @@
+/**
+ * @brief Compute shader, edge mask of an iteration buffer, for the supersampling.
+ *
+ *  A pixel is supersampled if its 3x3 neighbourhood mixes bounded and escaped
+ *  pixels, or if the variance of the smooth iteration count there is above
+ *  u_EdgeVariance: filaments and the boundary of the set, where 1 sample per
+ *  pixel aliases. Smooth regions are left at 1 sample.
+ *
+ * @param u_IterImage, iteration buffer, RG32F, (-1, 0) for bounded pixels.
+ * @param u_EdgeMask, R8, 1 for the pixels to supersample.
+ * @param u_Size, size of the rendered part of the buffers.
+ * @param u_EdgeVariance, variance threshold, in iterations^2.
+ * @param u_Active, count of the pixels to supersample, cleared by the host.
+ */
+
+#version 450 core
+
+layout(local_size_x = 16, local_size_y = 16) in;
+
+layout(rg32f, binding = 0) readonly uniform image2D u_IterImage;
+layout(r8, binding = 1) writeonly uniform image2D u_EdgeMask;
+
+layout(std430, binding = 4) buffer ActiveBuffer {
+    uint u_Active;
+};
+
+uniform ivec2 u_Size;
+uniform float u_EdgeVariance = 0.25;
+
+void main()
+{
+    ivec2 _p = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 _size = u_Size;
+    if (any(greaterThanEqual(_p, _size))) {
+        return;
+    }
+
+    int _n_bounded = 0;
+    int _n = 0;
+    float _s0 = 0.0;
+    float _sum = 0.0;
+    float _sum2 = 0.0;
+
+    for (int _dy = -1; _dy <= 1; ++_dy) {
+        for (int _dx = -1; _dx <= 1; ++_dx) {
+            vec2 _r = imageLoad(u_IterImage, clamp(_p + ivec2(_dx, _dy), ivec2(0), _size - 1)).xy;
+            if (_r.x < 0.0) {
+                ++_n_bounded;
+                continue;
+            }
+            // smooth iteration count, as the colouring pass
+            // shifted by the first one, the counts are large and close together
+            float _s = _r.x - log2(log2(_r.y));
+            if (_n == 0) {
+                _s0 = _s;
+            }
+            _s -= _s0;
+            _sum += _s;
+            _sum2 += _s * _s;
+            ++_n;
+        }
+    }
+
+    bool _b_edge = (_n_bounded > 0 && _n > 0);
+    if (!_b_edge && _n > 1) {
+        float _mean = _sum / float(_n);
+        _b_edge = (_sum2 / float(_n) - _mean * _mean) > u_EdgeVariance;
+    }
+
+    imageStore(u_EdgeMask, _p, vec4(_b_edge ? 1.0 : 0.0));
+    if (_b_edge) {
+        atomicAdd(u_Active, 1u);
+    }
+    return;
+}
@@ -0,0 +1,25 @@
+/**
+ * @brief Resolve of the supersampling accumulation buffer, the mean of the samples of each pixel.
+ *
+ * @param texCoords, texture coordinates.
+ * @param u_AccumTexture, RGBA32F, (sum of the sample colours, number of samples).
+ * @param u_TexScale, size of the rendered part of the buffer / its texture size.
+ *
+ * @return FragColor, pixel color.
+ */
+
+#version 450 core
+
+out vec4 FragColor;
+in vec2 texCoords;
+
+uniform sampler2D u_AccumTexture;
+uniform vec2 u_TexScale = vec2(1.0);
+
+void main()
+{
+    vec4 _acc = texture(u_AccumTexture, texCoords * u_TexScale);
+
+    FragColor = vec4(_acc.rgb / max(_acc.a, 1.0), 1.0);
+    return;
+}
@@ -0,0 +1,83 @@
+/**
+ * @brief Temporal upscaling of the sub-resolution frames, one jittered sample
+ *  per sub-resolution pixel and frame, blended into the reprojected history.
+ *
+ *  Each pixel takes the nearest sample of the frame, weighted by its
+ *  distance to the pixel centre, into the running weighted mean of the
+ *  history, (its alpha is the accumulated weight). The set does not move,
+ *  only the camera, so the history is valid wherever it covers the view.
+ *  The upsampled colour of the frame is a weak prior, it fills the pixels
+ *  the history does not cover.
+ *
+ * @param u_Samples, colours of the sub-resolution samples, RGBA8, nearest.
+ * @param u_SampleSize, size of the rendered part of u_Samples.
+ * @param u_Factor, view pixels per sample pixel.
+ * @param u_Jitter, offset of the samples of the frame, in sample pixels.
+ * @param u_SampleSigma, spread of the sample weights, view pixels.
+ * @param u_Prior, the upsampled colours of the frame, view size.
+ * @param u_History, RGBA16F, (colour, accumulated weight), linear.
+ * @param u_HistoryValid, 0 if there is no history.
+ * @param u_HistoryMap, history position of a view position, (scale, offset), in [0, 1].
+ * @param u_HistoryTexScale, size of the rendered part of the history / its texture size.
+ * @param u_HistoryGain, factor of the history weights, (less when zooming in).
+ * @param u_Size, view size.
+ *
+ * @return HistoryOut, the new history, (colour, accumulated weight).
+ */
+
+#version 450 core
+
+layout(location = 0) out vec4 HistoryOut;
+
+uniform sampler2D u_Samples;
+uniform ivec2 u_SampleSize;
+uniform float u_Factor = 8.0;
+uniform vec2 u_Jitter = vec2(0.0);
+uniform float u_SampleSigma = 1.0;
+
+uniform sampler2D u_Prior;
+
+uniform sampler2D u_History;
+uniform int u_HistoryValid = 0;
+uniform vec4 u_HistoryMap = vec4(1.0, 1.0, 0.0, 0.0);
+uniform vec2 u_HistoryTexScale = vec2(1.0);
+uniform float u_HistoryGain = 1.0;
+
+uniform ivec2 u_Size;
+
+// weight of the prior, and the most a history pixel accumulates
+#define PRIOR_WEIGHT 0.05
+#define MAX_WEIGHT 16.0
+
+void main()
+{
+    ivec2 _px = ivec2(gl_FragCoord.xy);
+    vec3 _prior = texelFetch(u_Prior, _px, 0).rgb;
+
+    // nearest sample, the sample k is at k + 0.5 + u_Jitter
+    vec2 _p = (vec2(_px) + 0.5) / u_Factor - 0.5 - u_Jitter;
+    ivec2 _k = clamp(ivec2(floor(_p + 0.5)), ivec2(0), u_SampleSize - 1);
+    vec2 _d = (_p - vec2(_k)) * u_Factor;
+    float _w = exp(-0.5 * dot(_d, _d) / (u_SampleSigma * u_SampleSigma));
+
+    vec3 _c = texelFetch(u_Samples, _k, 0).rgb;
+
+    // the history at the same plane position
+    vec4 _h = vec4(_prior, PRIOR_WEIGHT);
+    if (u_HistoryValid != 0) {
+        vec2 _uv = (vec2(_px) + 0.5) / vec2(u_Size) * u_HistoryMap.xy + u_HistoryMap.zw;
+
+        if (all(greaterThanEqual(_uv, vec2(0.0))) && all(lessThanEqual(_uv, vec2(1.0)))) {
+            // not filtered with the texels past the rendered part
+            vec2 _half_texel = 0.5 / vec2(u_Size);
+            vec4 _hist = texture(u_History, clamp(_uv, _half_texel, 1.0 - _half_texel) * u_HistoryTexScale);
+            float _a = _hist.a * u_HistoryGain;
+
+            _h = vec4((_hist.rgb * _a + _prior * PRIOR_WEIGHT) / (_a + PRIOR_WEIGHT), _a + PRIOR_WEIGHT);
+        }
+    }
+
+    float _sum = _h.a + _w;
+    HistoryOut = vec4((_h.rgb * _h.a + _c * _w) / _sum, min(_sum, MAX_WEIGHT));
+    return;
+}
@@ -82,8 +82,13 @@ void Input::check_keys(
  *
  * @param r_iter_ The reference to the iteration count.
  * @param b_mode_ The reference to the mode flag.
+ * @param b_xhair_ The reference to the crosshair flag.
+ * @param b_julia_ The reference to the Julia mode toggle flag.
+ * @param b_atlas_ The reference to the Julia atlas flag.
+ * @param b_palette_ The reference to the next palette flag.
+ * @param b_equalise_ The reference to the histogram equalisation toggle flag.
  */
-void Input::handle(int& r_iter_, bool& b_mode_, bool& b_xhair_) 
+void Input::handle(int& r_iter_, bool& b_mode_, bool& b_xhair_, bool& b_julia_, bool& b_atlas_, bool& b_palette_, bool& b_equalise_) 
 {
         
     // Iterate over each key code and its corresponding action
@@ -96,10 +101,27 @@ void Input::handle(int& r_iter_, bool& b_mode_, bool& b_xhair_)
     b_mode_ = m_pressed[GLFW_KEY_M];
     m_pressed[GLFW_KEY_M] = false; // Reset pressed state for 'M' key
 
+    // Next palette if 'P' is pressed
+    b_palette_ = m_pressed[GLFW_KEY_P];
+    m_pressed[GLFW_KEY_P] = false;
+
+    // Toggle histogram equalisation if 'H' is pressed
+    b_equalise_ = m_pressed[GLFW_KEY_H];
+    m_pressed[GLFW_KEY_H] = false;
+
+    // Toggle Julia mode if 'J' is pressed
+    b_julia_ = m_pressed[GLFW_KEY_J];
+    m_pressed[GLFW_KEY_J] = false;
+
     if (m_pressed[GLFW_KEY_X]) {
         b_xhair_ = !b_xhair_;
         m_pressed[GLFW_KEY_X] = false;
     }
+
+    if (m_pressed[GLFW_KEY_T]) {
+        b_atlas_ = !b_atlas_;
+        m_pressed[GLFW_KEY_T] = false;
+    }
     // Check if any key corresponding to r_iter_ is pressed
     for (const auto& pair : m_keyToRiterMap) {
         if (m_pressed[pair.first]) {
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "bla.h"
+
+namespace {
+
+/**
+ * @brief Merge two consecutive steps, x_ applied first, then y_.
+ *
+ *  A = Ay * Ax
+ *  B = Ay * Bx + By
+ *  r = min(rx, max(0, (ry - |Bx| * |dc|) / |Ax|))
+ */
+auto x_merge(const Bla_Step_t& x_, const Bla_Step_t& y_, double dc_max_)-> Bla_Step_t
+{
+    Bla_Step_t _z;
+    _z.Ax = y_.Ax * x_.Ax - y_.Ay * x_.Ay;
+    _z.Ay = y_.Ax * x_.Ay + y_.Ay * x_.Ax;
+    _z.Bx = (y_.Ax * x_.Bx - y_.Ay * x_.By) + y_.Bx;
+    _z.By = (y_.Ax * x_.By + y_.Ay * x_.Bx) + y_.By;
+
+    double _abs_Ax = std::hypot(x_.Ax, x_.Ay);
+    double _abs_Bx = std::hypot(x_.Bx, x_.By);
+    double _ry = (_abs_Ax > 0.) ? std::max(0., (y_.r - _abs_Bx * dc_max_) / _abs_Ax) : 0.;
+
+    _z.r = std::min(x_.r, _ry);
+    return _z;
+}
+
+} // namespace
+
+
+/**
+ * @brief Builds the BLA table of a reference orbit.
+ *
+ * @param[in] orbit_  reference orbit
+ * @param[in] dc_max_  largest |dc| of the view
+ * @param[in] eps_  precision of the deltas, 2^-53 for double, 2^-24 for float
+ * @param[out] rout_table_  the table
+ */
+void build_bla_table(
+    const Ref_Orbit_t& orbit_,
+    double dc_max_,
+    double eps_,
+    Bla_Table_t& rout_table_)
+{
+    rout_table_.steps.clear();
+    rout_table_.level_offset.clear();
+    rout_table_.level_count.clear();
+
+    // level 0, single steps n -> n+1:  dz' = 2*Z_n*dz + dc,
+    // dz^2 is negligible while |dz| < eps * |Z_n|
+    const int _n_steps = static_cast<int>(orbit_.points.size()) - 1;
+    if (_n_steps < 1) {
+        return;
+    }
+
+    rout_table_.steps.reserve(size_t(2) * _n_steps);
+    rout_table_.level_offset.push_back(0);
+    rout_table_.level_count.push_back(_n_steps);
+
+    for (int _n = 0; _n < _n_steps; ++_n) {
+        const Orbit_Point_t& _Z = orbit_.points[_n];
+        Bla_Step_t _s;
+        _s.Ax = 2. * _Z.x;
+        _s.Ay = 2. * _Z.y;
+        _s.Bx = 1.;
+        _s.By = 0.;
+        _s.r = eps_ * std::hypot(_Z.x, _Z.y);
+        rout_table_.steps.push_back(_s);
+    }
+
+    // merge level by level, only complete pairs
+    for (int _count = _n_steps / 2; _count > 0; _count /= 2) {
+        int _prev = rout_table_.level_offset.back();
+
+        rout_table_.level_offset.push_back(static_cast<int>(rout_table_.steps.size()));
+        rout_table_.level_count.push_back(_count);
+
+        for (int _i = 0; _i < _count; ++_i) {
+            rout_table_.steps.push_back(
+                x_merge(rout_table_.steps[_prev + 2 * _i], rout_table_.steps[_prev + 2 * _i + 1], dc_max_));
+        }
+    }
+    return;
+}
+
+/**
+ * @brief Finds the longest valid BLA step starting at orbit index n_.
+ *
+ * @param[in] table_  the table
+ * @param[in] n_  current index into the reference orbit
+ * @param[in] dz_norm2_  |dz|^2, in units of 2^(2 * dz_exp_)
+ * @param[in] dz_exp_  scale exponent of dz, 0 for plain deltas
+ * @param[in] max_len_  longest step allowed, e.g. iterations left
+ * @param[out] rout_len_  number of iterations skipped
+ *
+ * @return the step, nullptr if none is valid
+ */
+auto bla_lookup(
+    const Bla_Table_t& table_,
+    int n_,
+    double dz_norm2_,
+    int dz_exp_,
+    int max_len_,
+    int& rout_len_)-> const Bla_Step_t*
+{
+    if (n_ <= 0) {
+        return nullptr;
+    }
+
+    // an entry of level l starts at multiples of 2^l,
+    // level 0 costs the same as a normal step, so is never used
+    int _level = std::min(
+        std::countr_zero(static_cast<unsigned int>(n_)),
+        static_cast<int>(table_.level_count.size()) - 1);
+
+    for (; _level > 0; --_level) {
+        int _len = 1 << _level;
+        int _i = n_ >> _level;
+
+        if (_len > max_len_ || _i >= table_.level_count[_level]) {
+            continue;
+        }
+
+        const Bla_Step_t& _s = table_.steps[table_.level_offset[_level] + _i];
+
+        // |dz|^2 < r^2, tested in the scale of dz, overflows to inf (always valid)
+        double _r2 = _s.r * _s.r;
+        if (dz_norm2_ < ((dz_exp_ == 0) ? _r2 : std::ldexp(_r2, -2 * dz_exp_))) {
+            rout_len_ = _len;
+            return &_s;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Converts the table to the float layout of the shader storage buffer.
+ *
+ * @param[in] table_  the table
+ * @param[out] rout_steps_  float steps, same indexing as table_.steps
+ */
+void bla_to_gpu(const Bla_Table_t& table_, std::vector<Bla_Gpu_Step_t>& rout_steps_)
+{
+    rout_steps_.resize(table_.steps.size());
+
+    std::transform(table_.steps.begin(), table_.steps.end(), rout_steps_.begin(),
+        [](const Bla_Step_t& s_) {
+            return Bla_Gpu_Step_t{
+                static_cast<float>(s_.Ax), static_cast<float>(s_.Ay),
+                static_cast<float>(s_.Bx), static_cast<float>(s_.By),
+                static_cast<float>(s_.r), 0.f };
+        });
+    return;
+}
@@ -0,0 +1,598 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "headless.h"
+#include "perturbation.h"
+#include "escape_kernel.h"
+#include "julia_atlas.h"
+#include "palette.h"
+#include "shader_kernels.h"
+
+namespace {
+
+// Limbs of the fixed-point reference, 224 fraction bits
+constexpr int REF_FX_LIMBS = 8;
+using Ref_Fx_t = fixedPoint<REF_FX_LIMBS>;
+
+/**
+ * @brief Parse a decimal number into floatExp, "1.5e400" does not overflow.
+ */
+floatExp x_parse_fe(const char* str_)
+{
+    const char* _e = std::strpbrk(str_, "eE");
+    double _mant = std::strtod(std::string(str_, _e ? _e - str_ : std::strlen(str_)).c_str(), nullptr);
+    long _exp10 = _e ? std::strtol(_e + 1, nullptr, 10) : 0;
+
+    // 10^exp10 = 2^(exp10 * log2(10)), split into integer and fractional powers of 2
+    double _exp2 = _exp10 * std::log2(10.);
+    double _int2 = std::floor(_exp2);
+    return floatExp(_mant * std::exp2(_exp2 - _int2), static_cast<int>(_int2));
+}
+
+/**
+ * @brief Same colouring as the colouring pass, with the default palette.
+ *
+ *  Equalised if a CDF is given, (cdf_, of max_iter_).
+ */
+void x_color_func2(int iter_, float dist2_, unsigned char* rout_rgb_, const std::vector<float>* cdf_ = nullptr, int max_iter_ = 0)
+{
+    static const std::vector<float> s_palette = [] {
+        std::vector<float> _rgb;
+        build_palette(0, _rgb);
+        return _rgb;
+    }();
+
+    if (iter_ < 0) {
+        rout_rgb_[0] = rout_rgb_[1] = rout_rgb_[2] = 0;
+        return;
+    }
+
+    float _t = (cdf_ != nullptr)
+        ? equalised_coord(iter_, dist2_, max_iter_, *cdf_)
+        : palette_coord(iter_, dist2_);
+
+    float _rgb[3];
+    palette_lookup(s_palette, _t, _rgb);
+
+    for (int _c = 0; _c < 3; ++_c) {
+        rout_rgb_[_c] = static_cast<unsigned char>(std::lround(255.f * _rgb[_c]));
+    }
+    return;
+}
+
+/**
+ * @brief Write the rendered pixels as binary PPM, histogram-equalised if a CDF is given.
+ */
+bool x_write_ppm(const char* path_, int wd_, int ht_, const std::vector<Pixel_Result_t>& pixels_,
+    const std::vector<float>* cdf_ = nullptr, int max_iter_ = 0)
+{
+    std::ofstream _file(path_, std::ios::binary);
+    if (!_file.is_open()) {
+        return false;
+    }
+
+    _file << "P6\n" << wd_ << " " << ht_ << "\n255\n";
+
+    std::vector<unsigned char> _row(size_t(wd_) * 3);
+    for (int _j = 0; _j < ht_; ++_j) {
+        for (int _i = 0; _i < wd_; ++_i) {
+            const Pixel_Result_t& _px = pixels_[size_t(_j) * wd_ + _i];
+            x_color_func2(_px.iter, _px.dist2, &_row[size_t(_i) * 3], cdf_, max_iter_);
+        }
+        _file.write(reinterpret_cast<const char*>(_row.data()), _row.size());
+    }
+    return _file.good();
+}
+
+/**
+ * @brief Run f_(row) for every row, rows interleaved over the hardware threads.
+ */
+template<typename Func>
+void x_parallel_rows(int ht_, const Func& f_)
+{
+    const int _n_threads = std::max(1, std::min<int>(ht_, std::thread::hardware_concurrency()));
+
+    std::vector<std::thread> _threads;
+    for (int _t = 0; _t < _n_threads; ++_t) {
+        _threads.emplace_back([&f_, ht_, _t, _n_threads]() {
+            for (int _j = _t; _j < ht_; _j += _n_threads) {
+                f_(_j);
+            }
+        });
+    }
+    for (auto& _thread : _threads) {
+        _thread.join();
+    }
+    return;
+}
+
+/**
+ * @brief Difference map of a kernel against the reference, written as PPM.
+ *
+ *  black: same iteration, grey: log2 of the iteration difference,
+ *  red: inside the set in one and outside in the other.
+ */
+bool x_write_diff_ppm(
+    const char* path_, int wd_, int ht_,
+    const std::vector<Pixel_Result_t>& ref_,
+    const std::vector<Pixel_Result_t>& pixels_)
+{
+    std::ofstream _file(path_, std::ios::binary);
+    if (!_file.is_open()) {
+        return false;
+    }
+
+    _file << "P6\n" << wd_ << " " << ht_ << "\n255\n";
+
+    std::vector<unsigned char> _row(size_t(wd_) * 3);
+    for (int _j = 0; _j < ht_; ++_j) {
+        for (int _i = 0; _i < wd_; ++_i) {
+            size_t _k = size_t(_j) * wd_ + _i;
+            unsigned char* _rgb = &_row[size_t(_i) * 3];
+
+            if ((ref_[_k].iter < 0) != (pixels_[_k].iter < 0)) {
+                _rgb[0] = 255; _rgb[1] = 0; _rgb[2] = 0;
+                continue;
+            }
+            int _d = std::abs(ref_[_k].iter - pixels_[_k].iter);
+            unsigned char _v = static_cast<unsigned char>(std::min(255., 32. * std::log2(1. + _d)));
+            _rgb[0] = _rgb[1] = _rgb[2] = _v;
+        }
+        _file.write(reinterpret_cast<const char*>(_row.data()), _row.size());
+    }
+    return _file.good();
+}
+
+/**
+ * @brief --precision <cx> <cy> <zoom> <max_iter> <wd> <ht> <out_prefix>
+ *
+ *  Renders the view with the CPU mirrors of the S, dS and dD shader kernels,
+ *  and with the CPU perturbation, and compares them pixel by pixel against
+ *  a fixed-point reference at the c each of them takes, (float planePos for
+ *  the shader kernels, double for the perturbation). Writes <out_prefix>_ref.ppm, a difference map
+ *  <out_prefix>_<kernel>.ppm per kernel, and prints summary statistics.
+ */
+int x_precision(int argc, char** argv)
+{
+    if (argc < 9) {
+        std::cerr << "usage: " << argv[0] << " --precision <cx> <cy> <zoom> <max_iter> <wd> <ht> <out_prefix>\n";
+        return 1;
+    }
+
+    const double _cam_x = std::strtod(argv[2], nullptr);
+    const double _cam_y = std::strtod(argv[3], nullptr);
+    const double _zoom = std::strtod(argv[4], nullptr);
+    const int _max_iter = std::atoi(argv[5]);
+    const int _wd = std::atoi(argv[6]);
+    const int _ht = std::atoi(argv[7]);
+    const std::string _prefix = argv[8];
+
+    if (!(_zoom > 0.) || _wd <= 0 || _ht <= 0) {
+        std::cerr << "zoom, wd and ht must be positive\n";
+        return 1;
+    }
+
+    // bits between |c| (or |z| up to 2) and the pixel spacing, as for the
+    // automatic precision selection in main.cpp, compare with PRECISION_MODE_BITS
+    const double _spacing = 4. / (_zoom * _wd);
+    const double _bits = std::log2(std::max({ std::abs(_cam_x), std::abs(_cam_y), 2. }) / _spacing);
+    std::printf("pixel spacing: 2^%.1f, bits needed: %.1f\n", std::log2(_spacing), _bits);
+
+    if (_bits + 64. > 32. * (REF_FX_LIMBS - 1)) {
+        std::cerr << "warning: zoom too deep for the " << 32 * (REF_FX_LIMBS - 1)
+            << "-bit reference, its results are not exact\n";
+    }
+
+    Shader_Uniforms_t _u;
+    set_shader_uniforms(_cam_x, _cam_y, _zoom, _max_iter, _u);
+
+    const size_t _n = size_t(_wd) * _ht;
+    std::vector<Pixel_Result_t> _ref(_n);
+    std::vector<Pixel_Result_t> _ref_p(_n);
+
+    struct Kernel_t {
+        const char* name;
+        auto (*render)(float, float, const Shader_Uniforms_t&)-> Pixel_Result_t;
+        std::vector<Pixel_Result_t> pixels;
+        const std::vector<Pixel_Result_t>* ref; ///< reference at the c the kernel renders
+    };
+    std::vector<Kernel_t> _kernels = {
+        { "S",  shader_render_01_std, {}, &_ref },
+        { "dS", shader_render_01_ds,  {}, &_ref },
+        { "dD", shader_render_01_dd,  {}, &_ref },
+    };
+    for (Kernel_t& _kernel : _kernels) {
+        _kernel.pixels.resize(_n);
+    }
+
+    // the reference takes c exactly as the kernels define it from their
+    // uniforms, so only their arithmetic is measured, not the rounding of
+    // the camera and zoom into float uniforms
+    const Ref_Fx_t _fx_cam_x = Ref_Fx_t(double(_u.ds_cam_x[0])) + Ref_Fx_t(double(_u.ds_cam_x[1]));
+    const Ref_Fx_t _fx_cam_y = Ref_Fx_t(double(_u.ds_cam_y[0])) + Ref_Fx_t(double(_u.ds_cam_y[1]));
+    const Ref_Fx_t _fx_radius(2. * double(_u.zoom));
+
+    x_parallel_rows(_ht, [&](int j_) {
+        for (int _i = 0; _i < _wd; ++_i) {
+            size_t _k = size_t(j_) * _wd + _i;
+
+            // planePos at the pixel centre, as interpolated by the GPU
+            float _px = static_cast<float>(2. * (_i + 0.5) / _wd - 1.);
+            float _py = static_cast<float>(1. - 2. * (j_ + 0.5) / _ht);
+
+            // exact c of that planePos
+            _ref[_k] = escape_time(Mandelbrot_t{},
+                _fx_cam_x + _fx_radius * Ref_Fx_t(double(_px)),
+                _fx_cam_y + _fx_radius * Ref_Fx_t(double(_py)),
+                _max_iter);
+
+            // exact c of the planePos in double, as the perturbation takes it
+            _ref_p[_k] = escape_time(Mandelbrot_t{},
+                _fx_cam_x + _fx_radius * Ref_Fx_t(2. * (_i + 0.5) / _wd - 1.),
+                _fx_cam_y + _fx_radius * Ref_Fx_t(1. - 2. * (j_ + 0.5) / _ht),
+                _max_iter);
+
+            for (Kernel_t& _kernel : _kernels) {
+                _kernel.pixels[_k] = _kernel.render(_px, _py, _u);
+            }
+        }
+    });
+
+    // perturbation, same centre, but its planePos is in double rather than float,
+    // it is scored against the reference at its own c
+    Plane_View_t _view;
+    _view.cx = dd_add(deuxDouble(double(_u.ds_cam_x[0])), deuxDouble(double(_u.ds_cam_x[1])));
+    _view.cy = dd_add(deuxDouble(double(_u.ds_cam_y[0])), deuxDouble(double(_u.ds_cam_y[1])));
+    _view.radius = 2. * double(_u.zoom);
+    _view.wd = _wd;
+    _view.ht = _ht;
+
+    Ref_Orbit_t _orbit;
+    compute_reference_orbit(_view.cx, _view.cy, _max_iter, _orbit);
+    _kernels.push_back({ "P", nullptr, {}, &_ref_p });
+    render_perturbation_cpu(_orbit, _view, _max_iter, _kernels.back().pixels);
+
+    if (!x_write_ppm((_prefix + "_ref.ppm").c_str(), _wd, _ht, _ref)) {
+        std::cerr << "Failed to write: " << _prefix << "_ref.ppm\n";
+        return 1;
+    }
+
+    std::printf("%-6s %10s %10s %10s %8s\n", "kernel", "differ %", "in/out %", "mean |d|", "max |d|");
+
+    for (const Kernel_t& _kernel : _kernels) {
+        size_t _n_differ = 0;
+        size_t _n_inout = 0;
+        double _sum_d = 0.;
+        int _max_d = 0;
+
+        for (size_t _k = 0; _k < _n; ++_k) {
+            const Pixel_Result_t& _r = (*_kernel.ref)[_k];
+            const Pixel_Result_t& _p = _kernel.pixels[_k];
+
+            if (_r.iter == _p.iter) {
+                continue;
+            }
+            ++_n_differ;
+
+            if ((_r.iter < 0) != (_p.iter < 0)) {
+                ++_n_inout;
+                continue;
+            }
+            int _d = std::abs(_r.iter - _p.iter);
+            _sum_d += _d;
+            _max_d = std::max(_max_d, _d);
+        }
+
+        size_t _n_both = _n_differ - _n_inout;
+        std::printf("%-6s %10.3f %10.3f %10.2f %8d\n",
+            _kernel.name,
+            100. * _n_differ / _n,
+            100. * _n_inout / _n,
+            _n_both ? _sum_d / _n_both : 0.,
+            _max_d);
+
+        std::string _path = _prefix + "_" + _kernel.name + ".ppm";
+        if (!x_write_diff_ppm(_path.c_str(), _wd, _ht, *_kernel.ref, _kernel.pixels)) {
+            std::cerr << "Failed to write: " << _path << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Render a view with escape_time<T, Formula>, one instantiation per call.
+ */
+template<typename T, typename Formula>
+void x_render_direct(
+    const Formula& formula_,
+    double cam_x_, double cam_y_, double zoom_,
+    int max_iter_, int wd_, int ht_,
+    std::vector<Pixel_Result_t>& rout_pixels_)
+{
+    rout_pixels_.assign(size_t(wd_) * ht_, Pixel_Result_t{});
+
+    const T _cam_x(cam_x_);
+    const T _cam_y(cam_y_);
+    const T _radius(2. / zoom_);
+
+    x_parallel_rows(ht_, [&](int j_) {
+        for (int _i = 0; _i < wd_; ++_i) {
+            // same mapping as the shader, planePos in [-1, 1]
+            T _px(2. * (_i + 0.5) / wd_ - 1.);
+            T _py(1. - 2. * (j_ + 0.5) / ht_);
+
+            rout_pixels_[size_t(j_) * wd_ + _i] = escape_time(formula_,
+                T(_cam_x + _radius * _px),
+                T(_cam_y + _radius * _py),
+                max_iter_);
+        }
+    });
+    return;
+}
+
+/**
+ * @brief Select the formula, at run time once per render.
+ *
+ *  mandelbrot, burningship, multibrot:<2..8>, julia:<kx>,<ky>
+ */
+template<typename T>
+bool x_render_direct_formula(
+    const std::string& formula_,
+    double cam_x_, double cam_y_, double zoom_,
+    int max_iter_, int wd_, int ht_,
+    std::vector<Pixel_Result_t>& rout_pixels_)
+{
+    if (formula_ == "mandelbrot") {
+        x_render_direct<T>(Mandelbrot_t{}, cam_x_, cam_y_, zoom_, max_iter_, wd_, ht_, rout_pixels_);
+    }
+    else if (formula_ == "burningship") {
+        x_render_direct<T>(Burning_Ship_t{}, cam_x_, cam_y_, zoom_, max_iter_, wd_, ht_, rout_pixels_);
+    }
+    else if (formula_.rfind("julia:", 0) == 0) {
+        double _kx = 0., _ky = 0.;
+        if (std::sscanf(formula_.c_str() + 6, "%lf,%lf", &_kx, &_ky) != 2) {
+            return false;
+        }
+        x_render_direct<T>(Julia_t(_kx, _ky), cam_x_, cam_y_, zoom_, max_iter_, wd_, ht_, rout_pixels_);
+    }
+    else if (formula_.rfind("multibrot:", 0) == 0) {
+        switch (std::atoi(formula_.c_str() + 10)) {
+        case 2: x_render_direct<T>(Multibrot_t<2>{}, cam_x_, cam_y_, zoom_, max_iter_, wd_, ht_, rout_pixels_); break;
+        case 3: x_render_direct<T>(Multibrot_t<3>{}, cam_x_, cam_y_, zoom_, max_iter_, wd_, ht_, rout_pixels_); break;
+        case 4: x_render_direct<T>(Multibrot_t<4>{}, cam_x_, cam_y_, zoom_, max_iter_, wd_, ht_, rout_pixels_); break;
+        case 5: x_render_direct<T>(Multibrot_t<5>{}, cam_x_, cam_y_, zoom_, max_iter_, wd_, ht_, rout_pixels_); break;
+        case 6: x_render_direct<T>(Multibrot_t<6>{}, cam_x_, cam_y_, zoom_, max_iter_, wd_, ht_, rout_pixels_); break;
+        case 7: x_render_direct<T>(Multibrot_t<7>{}, cam_x_, cam_y_, zoom_, max_iter_, wd_, ht_, rout_pixels_); break;
+        case 8: x_render_direct<T>(Multibrot_t<8>{}, cam_x_, cam_y_, zoom_, max_iter_, wd_, ht_, rout_pixels_); break;
+        default: return false;
+        }
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief --direct <type> <formula> <cx> <cy> <zoom> <max_iter> <wd> <ht> <out.ppm>
+ *
+ *  Direct escape-time rendering, without perturbation.
+ *  type: float, double, dd (double-double), qd (quad-double), fx (fixed point, 224 bits)
+ */
+int x_direct(int argc, char** argv)
+{
+    if (argc < 11) {
+        std::cerr << "usage: " << argv[0]
+            << " --direct <float|double|dd|qd|fx> <mandelbrot|burningship|multibrot:<n>|julia:<kx>,<ky>>"
+            << " <cx> <cy> <zoom> <max_iter> <wd> <ht> <out.ppm>\n";
+        return 1;
+    }
+
+    const std::string _type = argv[2];
+    const std::string _formula = argv[3];
+    const double _cam_x = std::strtod(argv[4], nullptr);
+    const double _cam_y = std::strtod(argv[5], nullptr);
+    const double _zoom = std::strtod(argv[6], nullptr);
+    const int _max_iter = std::atoi(argv[7]);
+    const int _wd = std::atoi(argv[8]);
+    const int _ht = std::atoi(argv[9]);
+
+    std::vector<Pixel_Result_t> _pixels;
+    bool _b_ok = false;
+
+    if (_type == "float") {
+        _b_ok = x_render_direct_formula<float>(_formula, _cam_x, _cam_y, _zoom, _max_iter, _wd, _ht, _pixels);
+    }
+    else if (_type == "double") {
+        _b_ok = x_render_direct_formula<double>(_formula, _cam_x, _cam_y, _zoom, _max_iter, _wd, _ht, _pixels);
+    }
+    else if (_type == "dd") {
+        _b_ok = x_render_direct_formula<deuxDouble>(_formula, _cam_x, _cam_y, _zoom, _max_iter, _wd, _ht, _pixels);
+    }
+    else if (_type == "qd") {
+        _b_ok = x_render_direct_formula<quadDouble>(_formula, _cam_x, _cam_y, _zoom, _max_iter, _wd, _ht, _pixels);
+    }
+    else if (_type == "fx") {
+        _b_ok = x_render_direct_formula<Ref_Fx_t>(_formula, _cam_x, _cam_y, _zoom, _max_iter, _wd, _ht, _pixels);
+    }
+
+    if (!_b_ok) {
+        std::cerr << "unknown number type or formula: " << _type << " " << _formula << "\n";
+        return 1;
+    }
+
+    if (!x_write_ppm(argv[10], _wd, _ht, _pixels)) {
+        std::cerr << "Failed to write: " << argv[10] << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief --julia-atlas <cx> <cy> <view_width> <max_iter> <grid> <cell_px> <out.ppm>
+ *
+ *  The thumbnails of Julia_Atlas, the Julia sets of the lattice around
+ *  (cx, cy), in double, all rows of the atlas across the CPU threads.
+ */
+int x_julia_atlas(int argc, char** argv)
+{
+    if (argc < 9) {
+        std::cerr << "usage: " << argv[0]
+            << " --julia-atlas <cx> <cy> <view_width> <max_iter> <grid> <cell_px> <out.ppm>\n";
+        return 1;
+    }
+
+    const int _max_iter = std::atoi(argv[5]);
+    const int _grid = std::atoi(argv[6]);
+    const int _cell = std::atoi(argv[7]);
+
+    const Julia_Lattice_t _lattice = julia_lattice(
+        std::strtod(argv[2], nullptr),
+        std::strtod(argv[3], nullptr),
+        std::strtod(argv[4], nullptr),
+        _grid);
+
+    const int _wd = _grid * _cell;
+    std::vector<Pixel_Result_t> _pixels(size_t(_wd) * _wd);
+
+    x_parallel_rows(_wd, [&](int j_) {
+        // image rows go down, lattice rows go up
+        const int _lj = _grid - 1 - j_ / _cell;
+        const double _py = 1. - 2. * (j_ % _cell + 0.5) / _cell;
+        const Julia_t _julia_row(0., _lattice.cy(_lj));
+
+        for (int _i = 0; _i < _wd; ++_i) {
+            Julia_t _julia = _julia_row;
+            _julia.kx = _lattice.cx(_i / _cell);
+
+            // [-2, 2]^2, as in the atlas shader
+            const double _px = 2. * (_i % _cell + 0.5) / _cell - 1.;
+            _pixels[size_t(j_) * _wd + _i] = escape_time(_julia, 2. * _px, 2. * _py, _max_iter);
+        }
+    });
+
+    std::cout << "lattice spacing: " << _lattice.spacing
+        << ", c(0, 0) = " << _lattice.cx(0) << " " << _lattice.cy(0) << "\n";
+
+    if (!x_write_ppm(argv[8], _wd, _wd, _pixels)) {
+        std::cerr << "Failed to write: " << argv[8] << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Histogram of the escape iterations, same bins as histogram.comp.glsl.
+ *
+ *  Each thread counts a band of rows in its own histogram, no atomics,
+ *  the histograms are merged afterwards.
+ */
+void x_build_histogram(const std::vector<Pixel_Result_t>& pixels_, int max_iter_, std::vector<std::uint32_t>& rout_bins_)
+{
+    const size_t _n = pixels_.size();
+    const int _n_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::vector<std::uint32_t>> _local(_n_threads, std::vector<std::uint32_t>(HISTOGRAM_BINS, 0));
+
+    std::vector<std::thread> _threads;
+    for (int _t = 0; _t < _n_threads; ++_t) {
+        _threads.emplace_back([&, _t]() {
+            std::vector<std::uint32_t>& _bins = _local[_t];
+            for (size_t _k = _n * _t / _n_threads; _k < _n * (_t + 1) / _n_threads; ++_k) {
+                if (pixels_[_k].iter >= 0) {
+                    ++_bins[histogram_bin(pixels_[_k].iter, max_iter_)];
+                }
+            }
+        });
+    }
+    for (auto& _thread : _threads) {
+        _thread.join();
+    }
+
+    rout_bins_.assign(HISTOGRAM_BINS, 0);
+    for (const auto& _bins : _local) {
+        for (int _b = 0; _b < HISTOGRAM_BINS; ++_b) {
+            rout_bins_[_b] += _bins[_b];
+        }
+    }
+    return;
+}
+
+/**
+ * @brief --render <cx> <cy> <zoom> <max_iter> <wd> <ht> <out.ppm> [--equalise]
+ */
+int x_render(int argc, char** argv)
+{
+    if (argc < 9) {
+        std::cerr << "usage: " << argv[0] << " --render <cx> <cy> <zoom> <max_iter> <wd> <ht> <out.ppm> [--equalise]\n";
+        return 1;
+    }
+
+    Plane_View_t _view;
+    _view.cx = deuxDouble(std::strtod(argv[2], nullptr));
+    _view.cy = deuxDouble(std::strtod(argv[3], nullptr));
+    _view.radius = fe_div(2., x_parse_fe(argv[4])); // same as the shader, 2 / cameraZoom
+    _view.wd = std::atoi(argv[6]);
+    _view.ht = std::atoi(argv[7]);
+    int _max_iter = std::atoi(argv[5]);
+
+    Ref_Orbit_t _orbit;
+    compute_reference_orbit(_view.cx, _view.cy, _max_iter, _orbit);
+
+    std::vector<Pixel_Result_t> _pixels;
+    Render_Stats_t _stats = render_perturbation_cpu(_orbit, _view, _max_iter, _pixels);
+
+    std::cout << "references: " << _stats.n_references
+        << ", glitched pixels: " << _stats.n_glitched << "\n";
+
+    // histogram-equalised colours
+    std::vector<float> _cdf;
+    if (argc > 9 && std::strcmp(argv[9], "--equalise") == 0) {
+        std::vector<std::uint32_t> _bins;
+        x_build_histogram(_pixels, _max_iter, _bins);
+        build_cdf(_bins, _cdf);
+    }
+
+    if (!x_write_ppm(argv[8], _view.wd, _view.ht, _pixels, _cdf.empty() ? nullptr : &_cdf, _max_iter)) {
+        std::cerr << "Failed to write: " << argv[8] << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+
+/**
+ * @brief Entry point for command-line (window-less) operation.
+ *
+ * @param argc, argv  as passed to main()
+ * @return process exit code
+ */
+int run_headless(int argc, char** argv)
+{
+    if (std::strcmp(argv[1], "--render") == 0) {
+        return x_render(argc, argv);
+    }
+    if (std::strcmp(argv[1], "--precision") == 0) {
+        return x_precision(argc, argv);
+    }
+    if (std::strcmp(argv[1], "--direct") == 0) {
+        return x_direct(argc, argv);
+    }
+    if (std::strcmp(argv[1], "--julia-atlas") == 0) {
+        return x_julia_atlas(argc, argv);
+    }
+
+    std::cerr << "unknown option: " << argv[1] << "\n";
+    return 1;
+}
@@ -0,0 +1,284 @@
+#include <algorithm>
+#include <vector>
+
+#include "shader.h"
+#include "julia_atlas.h"
+
+namespace {
+
+/**
+ * @brief Per-instance attribute, one thumbnail to render.
+ */
+struct Instance_t {
+    float cx;
+    float cy;
+    float slot;
+    float reserved;
+};
+
+} // namespace
+
+
+/**
+ * @brief Creates the atlas textures, (iterations and colours), their
+ * framebuffers, and the shader.
+ *
+ * @param[in] grid_ lattice is (grid_ x grid_) thumbnails
+ * @param[in] cell_px_ thumbnail size in pixels
+ *
+ * @throw std::runtime_error if the shader fails to build
+ */
+Julia_Atlas::Julia_Atlas(int grid_, int cell_px_)
+    : m_grid(grid_), m_cell_px(cell_px_), m_slots_x(2 * grid_), m_slots_y(grid_)
+{
+    mp_shader = new Shader(
+        "shaders/julia_atlas.vs.glsl",
+        "shaders/julia_atlas.fs.glsl");
+
+    m_slots.resize(size_t(m_slots_x) * m_slots_y);
+    m_lattice_slots.assign(size_t(m_grid) * m_grid, 0);
+
+    // no filtering, iteration counts do not interpolate across the set's boundary
+    glGenTextures(1, &m_iter_texture);
+    glBindTexture(GL_TEXTURE_2D, m_iter_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32F,
+        width(), height(),
+        0, GL_RG, GL_FLOAT, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &m_iter_FBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_iter_FBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_iter_texture, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    x_clear_iterations();
+
+    glGenTextures(1, &m_texture);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
+        m_slots_x * m_cell_px, m_slots_y * m_cell_px,
+        0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenFramebuffers(1, &m_FBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    x_setup_buffers();
+}
+
+Julia_Atlas::~Julia_Atlas()
+{
+    glDeleteVertexArrays(1, &m_VAO);
+    glDeleteBuffers(1, &m_VBO);
+    glDeleteBuffers(1, &m_EBO);
+    glDeleteBuffers(1, &m_instance_VBO);
+    glDeleteFramebuffers(1, &m_FBO);
+    glDeleteTextures(1, &m_texture);
+    glDeleteFramebuffers(1, &m_iter_FBO);
+    glDeleteTextures(1, &m_iter_texture);
+
+    delete mp_shader;
+    mp_shader = nullptr;
+}
+
+/**
+ * @brief Brings the atlas up to the lattice around (cx_, cy_).
+ *
+ * @param[in] cx_, cy_ centre of the lattice, (the crosshair position)
+ * @param[in] view_width_ width of the view, the lattice spans about as much
+ * @param[in] max_iter_ iteration limit, a new one invalidates the atlas
+ *
+ * @return the number of thumbnails rendered
+ */
+auto Julia_Atlas::update(double cx_, double cy_, double view_width_, int max_iter_)-> int
+{
+    if (max_iter_ != m_max_iter) {
+        m_max_iter = max_iter_;
+        m_slot_of_c.clear();
+        for (Slot_t& _slot : m_slots) {
+            _slot.b_valid = false;
+        }
+        x_clear_iterations();
+    }
+
+    ++m_update_count;
+    const Julia_Lattice_t _lattice = julia_lattice(cx_, cy_, view_width_, m_grid);
+
+    // mark the cached cells first, so none of them is evicted by a new one
+    std::vector<int> _missing;
+    for (int _j = 0; _j < m_grid; ++_j) {
+        for (int _i = 0; _i < m_grid; ++_i) {
+            auto _it = m_slot_of_c.find({ _lattice.cx(_i), _lattice.cy(_j) });
+            if (_it == m_slot_of_c.end()) {
+                _missing.push_back(_j * m_grid + _i);
+                continue;
+            }
+            m_slots[_it->second].last_used = m_update_count;
+            m_lattice_slots[_j * m_grid + _i] = _it->second;
+        }
+    }
+
+    if (_missing.empty()) {
+        return 0;
+    }
+
+    std::vector<Instance_t> _instances;
+    _instances.reserve(_missing.size());
+
+    for (int _cell : _missing) {
+        int _s = x_acquire_slot();
+        Slot_t& _slot = m_slots[_s];
+
+        if (_slot.b_valid) {
+            m_slot_of_c.erase({ _slot.cx, _slot.cy });
+        }
+        _slot.cx = _lattice.cx(_cell % m_grid);
+        _slot.cy = _lattice.cy(_cell / m_grid);
+        _slot.last_used = m_update_count;
+        _slot.b_valid = true;
+
+        m_slot_of_c[{ _slot.cx, _slot.cy }] = _s;
+        m_lattice_slots[_cell] = _s;
+
+        _instances.push_back({ float(_slot.cx), float(_slot.cy), float(_s), 0.f });
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_instance_VBO);
+    glBufferData(GL_ARRAY_BUFFER, _instances.size() * sizeof(Instance_t), _instances.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // all the missing thumbnails in one draw, iterations are not blended
+    glBindFramebuffer(GL_FRAMEBUFFER, m_iter_FBO);
+    glViewport(0, 0, width(), height());
+    glDisable(GL_BLEND);
+
+    mp_shader->use_shader();
+    mp_shader->set_float("u_MaxIter", float(m_max_iter));
+    mp_shader->set_vec2("u_AtlasSlots", float(m_slots_x), float(m_slots_y));
+
+    glBindVertexArray(m_VAO);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, GLsizei(_instances.size()));
+    glBindVertexArray(0);
+
+    glEnable(GL_BLEND);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    return static_cast<int>(_instances.size());
+}
+
+/**
+ * @brief Draws the lattice over the default framebuffer, bottom row first.
+ *
+ * @param[in] wd_, ht_ size of the default framebuffer
+ */
+void Julia_Atlas::draw(int wd_, int ht_) const
+{
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_FBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+
+    for (int _j = 0; _j < m_grid; ++_j) {
+        for (int _i = 0; _i < m_grid; ++_i) {
+            int _s = m_lattice_slots[_j * m_grid + _i];
+            int _sx = (_s % m_slots_x) * m_cell_px;
+            int _sy = (_s / m_slots_x) * m_cell_px;
+
+            glBlitFramebuffer(
+                _sx, _sy, _sx + m_cell_px, _sy + m_cell_px,
+                wd_ * _i / m_grid, ht_ * _j / m_grid, wd_ * (_i + 1) / m_grid, ht_ * (_j + 1) / m_grid,
+                GL_COLOR_BUFFER_BIT,
+                GL_LINEAR);
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return;
+}
+
+/**
+ * @brief Quad, as in setup_buffers_for_quad_surface(), plus the per-instance attribute.
+ */
+void Julia_Atlas::x_setup_buffers()
+{
+    const float _quadVertices[] = {
+           -1.0f,  1.0f,
+           -1.0f, -1.0f,
+            1.0f, -1.0f,
+            1.0f,  1.0f,
+    };
+
+    const unsigned int _quadIndices[] = {
+            0, 1, 2,
+            0, 2, 3
+    };
+
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+    glGenBuffers(1, &m_EBO);
+    glGenBuffers(1, &m_instance_VBO);
+
+    glBindVertexArray(m_VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(_quadVertices), _quadVertices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_quadIndices), _quadIndices, GL_STATIC_DRAW);
+
+    // (c.x, c.y, slot, -), advanced once per instance
+    glBindBuffer(GL_ARRAY_BUFFER, m_instance_VBO);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Instance_t), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    return;
+}
+
+/**
+ * @brief All of the iteration atlas bounded, the free slots stay out of the histogram.
+ */
+void Julia_Atlas::x_clear_iterations()
+{
+    const float _bounded[4] = { -1.f, 0.f, 0.f, 0.f };
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_iter_FBO);
+    glClearBufferfv(GL_COLOR, 0, _bounded);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return;
+}
+
+/**
+ * @brief A free slot, or else the least recently used one not in the current lattice.
+ */
+auto Julia_Atlas::x_acquire_slot()-> int
+{
+    int _lru = -1;
+    for (int _s = 0; _s < int(m_slots.size()); ++_s) {
+        const Slot_t& _slot = m_slots[_s];
+        if (!_slot.b_valid) {
+            return _s;
+        }
+        if (_slot.last_used == m_update_count) {
+            continue;
+        }
+        if (_lru < 0 || _slot.last_used < m_slots[_lru].last_used) {
+            _lru = _s;
+        }
+    }
+    // the atlas holds twice the lattice, there is always one
+    return _lru;
+}
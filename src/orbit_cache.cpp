@@ -0,0 +1,383 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "orbit_cache.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Arithmetic of compute_reference_orbit(), double-double.
+// Part of the key: orbits of a more precise reference are different orbits.
+constexpr std::int32_t REF_PRECISION_BITS = 106;
+
+constexpr char ORBIT_FILE_MAGIC[8] = { 'M', 'B', 'D', 'O', 'R', 'B', '1', '\0' };
+
+/**
+ * @brief Header of an orbit file, followed by n_points Orbit_Point_t.
+ */
+struct File_Header_t {
+    char          magic[8];
+    std::int32_t  precision_bits;
+    std::int32_t  max_iter;
+    std::int32_t  escaped;
+    std::int32_t  reserved;
+    std::uint64_t n_points;
+    double cx[2], cy[2];    ///< reference point, (val, err)
+    double zx[2], zy[2];    ///< last z, (val, err)
+};
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ */
+class Mapped_File_t
+{
+public:
+    explicit Mapped_File_t(const fs::path& path_)
+    {
+#ifdef _WIN32
+        m_file = CreateFileW(path_.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        LARGE_INTEGER _size;
+        if (!GetFileSizeEx(m_file, &_size) || _size.QuadPart == 0) {
+            return;
+        }
+
+        m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping == nullptr) {
+            return;
+        }
+
+        m_data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+        if (m_data != nullptr) {
+            m_size = static_cast<size_t>(_size.QuadPart);
+        }
+#else
+        m_fd = open(path_.c_str(), O_RDONLY);
+        if (m_fd < 0) {
+            return;
+        }
+
+        struct stat _st;
+        if (fstat(m_fd, &_st) != 0 || _st.st_size == 0) {
+            return;
+        }
+
+        void* _p = mmap(nullptr, static_cast<size_t>(_st.st_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (_p != MAP_FAILED) {
+            m_data = _p;
+            m_size = static_cast<size_t>(_st.st_size);
+        }
+#endif
+    }
+
+    ~Mapped_File_t()
+    {
+#ifdef _WIN32
+        if (m_data != nullptr) UnmapViewOfFile(m_data);
+        if (m_mapping != nullptr) CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+#else
+        if (m_data != nullptr) munmap(m_data, m_size);
+        if (m_fd >= 0) close(m_fd);
+#endif
+    }
+
+    Mapped_File_t(const Mapped_File_t&) = delete;
+    Mapped_File_t& operator=(const Mapped_File_t&) = delete;
+
+    auto data() const-> const unsigned char* { return static_cast<const unsigned char*>(m_data); }
+    auto size() const-> size_t { return m_size; }
+
+private:
+    void*  m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    int    m_fd = -1;
+#endif
+};
+
+/**
+ * @brief File name of an orbit, FNV-1a hash of its key.
+ *
+ *  Collisions are caught when loading, the key is also in the header.
+ *  The max iteration is not part of it, a centre has one file, its longest orbit.
+ */
+auto x_file_name(const deuxDouble& cx_, const deuxDouble& cy_)-> std::string
+{
+    const double _key_d[4] = { cx_.val, cx_.err, cy_.val, cy_.err };
+    const std::int32_t _key_i[1] = { REF_PRECISION_BITS };
+
+    std::uint64_t _hash = 14695981039346656037ull;
+    auto _mix = [&_hash](const void* p_, size_t n_) {
+        const unsigned char* _b = static_cast<const unsigned char*>(p_);
+        for (size_t _i = 0; _i < n_; ++_i) {
+            _hash = (_hash ^ _b[_i]) * 1099511628211ull;
+        }
+    };
+    _mix(_key_d, sizeof(_key_d));
+    _mix(_key_i, sizeof(_key_i));
+
+    return std::format("{:016x}.orbit", _hash);
+}
+
+} // namespace
+
+
+/**
+ * @brief Opens the cache directory, creating it if needed.
+ *
+ * @param dir_ directory of the orbit files
+ * @param max_bytes_ total size the files may take, before eviction
+ */
+Orbit_Cache::Orbit_Cache(const fs::path& dir_, std::uintmax_t max_bytes_)
+    : m_dir(dir_), m_max_bytes(max_bytes_)
+{
+    std::error_code _ec;
+    fs::create_directories(m_dir, _ec);
+    if (_ec) {
+        std::cout << "Orbit cache disabled, cannot create: " << m_dir << "\n";
+        return;
+    }
+
+    x_scan();
+    x_evict();
+}
+
+/**
+ * @brief Loads a cached orbit, computed for max_iter_ or a higher limit.
+ *
+ *  A longer orbit is returned as it is, its first points are the orbit for
+ *  max_iter_, and its last z is kept for a later extension. An orbit that
+ *  escaped is complete for any limit.
+ *
+ * @param[in] cx_, cy_ reference point
+ * @param[in] max_iter_ iteration limit
+ * @param[out] rout_orbit_ the orbit, untouched on a miss
+ *
+ * @return true on a hit
+ */
+auto Orbit_Cache::load(
+    const deuxDouble& cx_,
+    const deuxDouble& cy_,
+    int max_iter_,
+    Ref_Orbit_t& rout_orbit_)-> bool
+{
+    std::string _name = x_file_name(cx_, cy_);
+    if (m_index.find(_name) == m_index.end()) {
+        return false;
+    }
+
+    Mapped_File_t _file(m_dir / _name);
+    if (_file.size() < sizeof(File_Header_t)) {
+        x_remove(_name);
+        return false;
+    }
+
+    File_Header_t _hdr;
+    std::memcpy(&_hdr, _file.data(), sizeof(_hdr));
+
+    bool _b_valid = std::memcmp(_hdr.magic, ORBIT_FILE_MAGIC, sizeof(ORBIT_FILE_MAGIC)) == 0
+        && _hdr.precision_bits == REF_PRECISION_BITS
+        && _file.size() == sizeof(File_Header_t) + _hdr.n_points * sizeof(Orbit_Point_t);
+
+    if (!_b_valid) {
+        // corrupt, or from another version of the program
+        x_remove(_name);
+        return false;
+    }
+
+    if (_hdr.cx[0] != cx_.val || _hdr.cx[1] != cx_.err
+        || _hdr.cy[0] != cy_.val || _hdr.cy[1] != cy_.err) {
+        // hash collision, keep the other orbit
+        return false;
+    }
+
+    if (_hdr.max_iter < max_iter_ && _hdr.escaped == 0) {
+        // too short, it is replaced once the longer orbit is stored
+        return false;
+    }
+
+    rout_orbit_.cx = cx_;
+    rout_orbit_.cy = cy_;
+    rout_orbit_.zx.val = _hdr.zx[0];
+    rout_orbit_.zx.err = _hdr.zx[1];
+    rout_orbit_.zy.val = _hdr.zy[0];
+    rout_orbit_.zy.err = _hdr.zy[1];
+    rout_orbit_.max_iter = std::max<int>(_hdr.max_iter, max_iter_);
+    rout_orbit_.escaped = (_hdr.escaped != 0);
+
+    rout_orbit_.points.resize(static_cast<size_t>(_hdr.n_points));
+    std::memcpy(rout_orbit_.points.data(),
+        _file.data() + sizeof(File_Header_t),
+        rout_orbit_.points.size() * sizeof(Orbit_Point_t));
+
+    x_touch(_name);
+    return true;
+}
+
+/**
+ * @brief Adds an orbit to the cache, evicting the least recently used ones if needed.
+ *
+ *  An extended orbit replaces the shorter one of the same centre.
+ *
+ * @param[in] orbit_ the orbit, as computed by compute_reference_orbit()
+ */
+void Orbit_Cache::store(const Ref_Orbit_t& orbit_)
+{
+    std::string _name = x_file_name(orbit_.cx, orbit_.cy);
+
+    File_Header_t _hdr{};
+    std::memcpy(_hdr.magic, ORBIT_FILE_MAGIC, sizeof(ORBIT_FILE_MAGIC));
+    _hdr.precision_bits = REF_PRECISION_BITS;
+    _hdr.max_iter = orbit_.max_iter;
+    _hdr.escaped = orbit_.escaped ? 1 : 0;
+    _hdr.n_points = orbit_.points.size();
+    _hdr.cx[0] = orbit_.cx.val; _hdr.cx[1] = orbit_.cx.err;
+    _hdr.cy[0] = orbit_.cy.val; _hdr.cy[1] = orbit_.cy.err;
+    _hdr.zx[0] = orbit_.zx.val; _hdr.zx[1] = orbit_.zx.err;
+    _hdr.zy[0] = orbit_.zy.val; _hdr.zy[1] = orbit_.zy.err;
+
+    // write aside, then rename, a crash never leaves a partial orbit file
+    fs::path _tmp = m_dir / (_name + ".tmp");
+    {
+        std::ofstream _out(_tmp, std::ios::binary | std::ios::trunc);
+        _out.write(reinterpret_cast<const char*>(&_hdr), sizeof(_hdr));
+        _out.write(reinterpret_cast<const char*>(orbit_.points.data()),
+            orbit_.points.size() * sizeof(Orbit_Point_t));
+
+        if (!_out.good()) {
+            _out.close();
+            std::error_code _ec;
+            fs::remove(_tmp, _ec);
+            return;
+        }
+    }
+
+    x_remove(_name);
+
+    std::error_code _ec;
+    fs::rename(_tmp, m_dir / _name, _ec);
+    if (_ec) {
+        fs::remove(_tmp, _ec);
+        return;
+    }
+
+    x_insert(_name, sizeof(File_Header_t) + orbit_.points.size() * sizeof(Orbit_Point_t));
+    x_evict();
+    return;
+}
+
+/**
+ * @brief Builds the LRU list from the files on disk, newest first.
+ */
+void Orbit_Cache::x_scan()
+{
+    struct Found_t {
+        fs::file_time_type time;
+        std::string name;
+        std::uintmax_t bytes;
+    };
+    std::vector<Found_t> _found;
+
+    std::error_code _ec;
+    for (const fs::directory_entry& _de : fs::directory_iterator(m_dir, _ec)) {
+        if (!_de.is_regular_file(_ec) || _de.path().extension() != ".orbit") {
+            continue;
+        }
+        _found.push_back({ _de.last_write_time(_ec), _de.path().filename().string(), _de.file_size(_ec) });
+    }
+
+    std::sort(_found.begin(), _found.end(),
+        [](const Found_t& a_, const Found_t& b_) { return a_.time > b_.time; });
+
+    for (const Found_t& _f : _found) {
+        m_lru.push_back({ _f.name, _f.bytes });
+        m_index[_f.name] = std::prev(m_lru.end());
+        m_total_bytes += _f.bytes;
+    }
+    return;
+}
+
+/**
+ * @brief Marks an entry as most recently used, on disk as well.
+ */
+void Orbit_Cache::x_touch(const std::string& name_)
+{
+    auto _it = m_index.find(name_);
+    if (_it == m_index.end()) {
+        return;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, _it->second);
+
+    std::error_code _ec;
+    fs::last_write_time(m_dir / name_, fs::file_time_type::clock::now(), _ec);
+    return;
+}
+
+/**
+ * @brief Adds an entry as most recently used.
+ */
+void Orbit_Cache::x_insert(const std::string& name_, std::uintmax_t bytes_)
+{
+    m_lru.push_front({ name_, bytes_ });
+    m_index[name_] = m_lru.begin();
+    m_total_bytes += bytes_;
+    return;
+}
+
+/**
+ * @brief Removes an entry, and its file.
+ */
+void Orbit_Cache::x_remove(const std::string& name_)
+{
+    auto _it = m_index.find(name_);
+    if (_it == m_index.end()) {
+        return;
+    }
+
+    m_total_bytes -= _it->second->bytes;
+    m_lru.erase(_it->second);
+    m_index.erase(_it);
+
+    std::error_code _ec;
+    fs::remove(m_dir / name_, _ec);
+    return;
+}
+
+/**
+ * @brief Removes the least recently used entries until the cache fits its budget.
+ *
+ *  The most recent entry is always kept, even if larger than the budget.
+ */
+void Orbit_Cache::x_evict()
+{
+    while (m_total_bytes > m_max_bytes && m_lru.size() > 1) {
+        std::string _name = m_lru.back().name; // a copy, x_remove() erases the entry
+        x_remove(_name);
+    }
+    return;
+}
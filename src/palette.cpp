@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "palette.h"
+
+namespace {
+
+/**
+ * @brief Samples a wrapping gradient at the palette entries.
+ */
+template<size_t N>
+void x_build_gradient(const Palette_Stop_t (&stops_)[N], std::vector<float>& rout_rgb_)
+{
+    for (int _k = 0; _k < PALETTE_SIZE; ++_k) {
+        float _t = float(_k) / PALETTE_SIZE;
+
+        // stops _s and _s + 1 (wrapped) around _t
+        size_t _s = N - 1;
+        for (size_t _i = 0; _i < N; ++_i) {
+            if (stops_[_i].t <= _t) {
+                _s = _i;
+            }
+        }
+        const Palette_Stop_t& _a = stops_[_s];
+        const Palette_Stop_t& _b = stops_[(_s + 1) % N];
+
+        float _t0 = _a.t;
+        float _t1 = (_b.t > _a.t) ? _b.t : _b.t + 1.f;
+        float _tt = (_t >= _t0) ? _t : _t + 1.f;
+        float _w = (_tt - _t0) / (_t1 - _t0);
+
+        for (int _c = 0; _c < 3; ++_c) {
+            rout_rgb_[size_t(_k) * 3 + _c] = _a.rgb[_c] + (_b.rgb[_c] - _a.rgb[_c]) * _w;
+        }
+    }
+    return;
+}
+
+} // namespace
+
+
+/**
+ * @brief Builds a palette.
+ *
+ * @param[in] palette_ 0: cosine (colorFunc2), 1: fire, 2: ocean, 3: grey
+ * @param[out] rout_rgb_ PALETTE_SIZE RGB entries, in [0, 1]
+ */
+void build_palette(int palette_, std::vector<float>& rout_rgb_)
+{
+    rout_rgb_.assign(size_t(PALETTE_SIZE) * 3, 0.f);
+
+    switch (palette_) {
+    case 1:
+        x_build_gradient(PALETTE_FIRE, rout_rgb_);
+        break;
+    case 2:
+        x_build_gradient(PALETTE_OCEAN, rout_rgb_);
+        break;
+    case 3:
+        x_build_gradient(PALETTE_GREY, rout_rgb_);
+        break;
+    default:
+    {
+        const float _offs[3] = { 0.f, .6f, 1.f };
+        for (int _k = 0; _k < PALETTE_SIZE; ++_k) {
+            float _phase = 2.f * std::numbers::pi_v<float> * _k / PALETTE_SIZE;
+            for (int _c = 0; _c < 3; ++_c) {
+                rout_rgb_[size_t(_k) * 3 + _c] = 0.5f + 0.5f * std::cos(_phase + _offs[_c]);
+            }
+        }
+        break;
+    }
+    }
+    return;
+}
+
+/**
+ * @brief Palette coordinate of an escaped pixel.
+ *
+ * @param[in] iter_ escape iteration
+ * @param[in] dist2_ |z|^2 at escape
+ *
+ * @return t, the palette repeats with period 1
+ */
+auto palette_coord(int iter_, float dist2_)-> float
+{
+    float _sl = (float(iter_) - std::log2(std::log2(dist2_)) + 4.f) * .0025f;
+    return (2.7f + _sl * 30.f) / (2.f * std::numbers::pi_v<float>);
+}
+
+/**
+ * @brief Palette colour at t_, linear filter between the entry centres, repeat wrap.
+ *
+ * @param[in] rgb_ palette, from build_palette()
+ * @param[in] t_ palette coordinate
+ * @param[out] rout_rgb_ colour, 3 floats
+ */
+void palette_lookup(const std::vector<float>& rgb_, float t_, float* rout_rgb_)
+{
+    float _u = (t_ - std::floor(t_)) * PALETTE_SIZE - 0.5f;
+    float _f = std::floor(_u);
+    float _w = _u - _f;
+
+    int _k0 = (int(_f) + PALETTE_SIZE) % PALETTE_SIZE;
+    int _k1 = (_k0 + 1) % PALETTE_SIZE;
+
+    for (int _c = 0; _c < 3; ++_c) {
+        rout_rgb_[_c] = rgb_[size_t(_k0) * 3 + _c] * (1.f - _w) + rgb_[size_t(_k1) * 3 + _c] * _w;
+    }
+    return;
+}
+
+/**
+ * @brief CDF of a histogram.
+ *
+ * @param[in] bins_ HISTOGRAM_BINS counts
+ * @param[out] rout_cdf_ cdf[k] = (count of bins 0..k) / total, 0 if empty
+ */
+void build_cdf(const std::vector<std::uint32_t>& bins_, std::vector<float>& rout_cdf_)
+{
+    rout_cdf_.assign(bins_.size(), 0.f);
+
+    std::uint64_t _total = 0;
+    for (std::uint32_t _count : bins_) {
+        _total += _count;
+    }
+    if (_total == 0) {
+        return;
+    }
+
+    std::uint64_t _sum = 0;
+    for (size_t _k = 0; _k < bins_.size(); ++_k) {
+        _sum += bins_[_k];
+        rout_cdf_[_k] = float(double(_sum) / double(_total));
+    }
+    return;
+}
+
+/**
+ * @brief Equalised palette coordinate, same as the colouring pass.
+ *
+ * @param[in] iter_ escape iteration
+ * @param[in] dist2_ |z|^2 at escape
+ * @param[in] max_iter_ iteration limit, of the histogram
+ * @param[in] cdf_ from build_cdf()
+ *
+ * @return t in [0, 1]
+ */
+auto equalised_coord(int iter_, float dist2_, int max_iter_, const std::vector<float>& cdf_)-> float
+{
+    // fraction of the smooth count, in [0, 1), |z|^2 just past 4 gives log2(log2()) just past 1
+    float _frac = std::clamp(2.f - std::log2(std::log2(dist2_)), 0.f, 0.999f);
+
+    // position in the bin, a bin is one iteration, or (max_iter / HISTOGRAM_BINS) of them
+    int _k = histogram_bin(iter_, max_iter_);
+    float _w = (max_iter_ <= HISTOGRAM_BINS)
+        ? _frac
+        : std::clamp((float(iter_) + _frac) * HISTOGRAM_BINS / float(max_iter_) - float(_k), 0.f, 1.f);
+
+    float _c0 = (_k > 0) ? cdf_[_k - 1] : 0.f;
+    float _c1 = cdf_[_k];
+
+    return _c0 + (_c1 - _c0) * _w;
+}
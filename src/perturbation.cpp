@@ -0,0 +1,504 @@
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include "perturbation.h"
+#include "bla.h"
+
+namespace {
+
+// Below 2^FE_RESCALE_EXP the deltas (and their squares) no longer fit
+// a double, and are iterated rescaled instead.
+constexpr int FE_RESCALE_EXP = -960;
+
+// Pauldelbrot's glitch criterion, |z|^2 < GLITCH_TOL * |Z|^2
+constexpr double GLITCH_TOL = 1e-6;
+
+// Limits of the multi-reference passes
+constexpr int MAX_GLITCH_PASSES = 8;
+constexpr int MAX_REFS_PER_PASS = 32;
+
+// BLA validity, relative error allowed per skip. 2^-53 hardly ever
+// skips, 2^-24 (float precision) shifts the iteration count of about
+// 1 in 7 boundary pixels at zoom 1e13, 2^-40 is below 1 in 100.
+constexpr double BLA_EPS = 0x1p-40;
+
+/**
+ * @brief Continue the reference orbit until max_iter_, or escape.
+ */
+void x_iterate_reference(Ref_Orbit_t& rio_orbit_, int max_iter_)
+{
+    deuxDouble _zx = rio_orbit_.zx;
+    deuxDouble _zy = rio_orbit_.zy;
+
+    while (int(rio_orbit_.points.size()) <= max_iter_ + 1) {
+        // z = z^2 + c
+        deuxDouble _zx2 = dd_mul(_zx, _zx);
+        deuxDouble _zy2 = dd_mul(_zy, _zy);
+        deuxDouble _zxy = dd_mul(_zx, _zy);
+
+        _zy = dd_add(dd_add(_zxy, _zxy), rio_orbit_.cy);
+        _zx = dd_add(dd_sub(_zx2, _zy2), rio_orbit_.cx);
+
+        rio_orbit_.points.push_back({ _zx.val, _zy.val });
+
+        if ((_zx.val * _zx.val + _zy.val * _zy.val) > 4.) {
+            rio_orbit_.escaped = true;
+            break;
+        }
+    }
+
+    rio_orbit_.zx = _zx;
+    rio_orbit_.zy = _zy;
+    return;
+}
+
+/**
+ * @brief Perturbation loop with double deltas, from state (dz, n, iter).
+ */
+auto x_iterate_double(
+    const Ref_Orbit_t& orbit_,
+    const Bla_Table_t* bla_,
+    double dcx_, double dcy_,
+    double dzx_, double dzy_,
+    int n_, int iter_, int max_iter_)-> Pixel_Result_t
+{
+    const Orbit_Point_t* _Z = orbit_.points.data();
+    const int _last = int(orbit_.points.size()) - 1;
+
+    while (iter_ < max_iter_) {
+        int _len = 0;
+        const Bla_Step_t* _bla = (bla_ != nullptr)
+            ? bla_lookup(*bla_, n_, dzx_ * dzx_ + dzy_ * dzy_, 0, max_iter_ - iter_, _len)
+            : nullptr;
+
+        if (_bla != nullptr) {
+            // skip _len iterations, dz' = A*dz + B*dc
+            double _tx = (_bla->Ax * dzx_ - _bla->Ay * dzy_) + (_bla->Bx * dcx_ - _bla->By * dcy_);
+            double _ty = (_bla->Ax * dzy_ + _bla->Ay * dzx_) + (_bla->Bx * dcy_ + _bla->By * dcx_);
+            dzx_ = _tx;
+            dzy_ = _ty;
+            n_ += _len;
+            iter_ += _len - 1;
+        }
+        else {
+            // dz' = 2*Z*dz + dz^2 + dc
+            double _tx = 2. * (_Z[n_].x * dzx_ - _Z[n_].y * dzy_) + (dzx_ * dzx_ - dzy_ * dzy_) + dcx_;
+            double _ty = 2. * (_Z[n_].x * dzy_ + _Z[n_].y * dzx_) + (2. * dzx_ * dzy_) + dcy_;
+            dzx_ = _tx;
+            dzy_ = _ty;
+            ++n_;
+        }
+
+        double _x = _Z[n_].x + dzx_;
+        double _y = _Z[n_].y + dzy_;
+        double _dist = _x * _x + _y * _y;
+
+        if (_dist > 4.) {
+            return { iter_, static_cast<float>(_dist) };
+        }
+
+        double _Zdist = _Z[n_].x * _Z[n_].x + _Z[n_].y * _Z[n_].y;
+        if (_dist < GLITCH_TOL * _Zdist) {
+            return { -1, static_cast<float>(_dist / _Zdist), true };
+        }
+
+        if (n_ == _last) {
+            // end of an escaped reference, continue relative to Z_0 = 0
+            dzx_ = _x;
+            dzy_ = _y;
+            n_ = 0;
+        }
+        ++iter_;
+    }
+    return {};
+}
+
+/**
+ * @brief Perturbation loop with rescaled deltas, dz = w * 2^e.
+ *
+ *  w is kept near unit magnitude, so neither w nor w^2 underflows:
+ *      w' = 2*Z*w + 2^e * w^2 + dc / 2^e
+ *  Once 2^e climbs into the double range, continue in x_iterate_double().
+ */
+auto x_iterate_rescaled(
+    const Ref_Orbit_t& orbit_,
+    const Bla_Table_t* bla_,
+    const floatExp& dcx_,
+    const floatExp& dcy_,
+    int max_iter_)-> Pixel_Result_t
+{
+    const Orbit_Point_t* _Z = orbit_.points.data();
+    const int _last = int(orbit_.points.size()) - 1;
+
+    // dc with a shared exponent
+    const int _dce = std::max(dcx_.exp, dcy_.exp);
+    const double _dcwx = std::ldexp(dcx_.mant, dcx_.exp - _dce);
+    const double _dcwy = std::ldexp(dcy_.mant, dcy_.exp - _dce);
+
+    double _wx = 0.;
+    double _wy = 0.;
+    int _e = _dce;
+    int _n = 0;
+
+    for (int _iter = 0; _iter < max_iter_; ++_iter) {
+        double _s = std::ldexp(1., _e);          // underflows to 0 when negligible
+        double _dcs = std::ldexp(1., _dce - _e);
+
+        int _len = 0;
+        const Bla_Step_t* _bla = (bla_ != nullptr)
+            ? bla_lookup(*bla_, _n, _wx * _wx + _wy * _wy, _e, max_iter_ - _iter, _len)
+            : nullptr;
+
+        if (_bla != nullptr) {
+            // skip _len iterations, w' = A*w + B*dc / 2^e
+            double _tx = (_bla->Ax * _wx - _bla->Ay * _wy) + (_bla->Bx * _dcwx - _bla->By * _dcwy) * _dcs;
+            double _ty = (_bla->Ax * _wy + _bla->Ay * _wx) + (_bla->Bx * _dcwy + _bla->By * _dcwx) * _dcs;
+            _wx = _tx;
+            _wy = _ty;
+            _n += _len;
+            _iter += _len - 1;
+        }
+        else {
+            double _tx = 2. * (_Z[_n].x * _wx - _Z[_n].y * _wy) + _s * (_wx * _wx - _wy * _wy) + _dcwx * _dcs;
+            double _ty = 2. * (_Z[_n].x * _wy + _Z[_n].y * _wx) + _s * (2. * _wx * _wy) + _dcwy * _dcs;
+            _wx = _tx;
+            _wy = _ty;
+            ++_n;
+        }
+
+        // renormalise w
+        double _m = std::max(std::fabs(_wx), std::fabs(_wy));
+        if (_m != 0. && (_m > 0x1p32 || _m < 0x1p-32)) {
+            int _k;
+            std::frexp(_m, &_k);
+            _wx = std::ldexp(_wx, -_k);
+            _wy = std::ldexp(_wy, -_k);
+            _e += _k;
+        }
+
+        double _x = _Z[_n].x + std::ldexp(_wx, _e);
+        double _y = _Z[_n].y + std::ldexp(_wy, _e);
+        double _dist = _x * _x + _y * _y;
+
+        if (_dist > 4.) {
+            return { _iter, static_cast<float>(_dist) };
+        }
+
+        double _Zdist = _Z[_n].x * _Z[_n].x + _Z[_n].y * _Z[_n].y;
+        if (_dist < GLITCH_TOL * _Zdist) {
+            return { -1, static_cast<float>(_dist / _Zdist), true };
+        }
+
+        if (_n == _last) {
+            // end of an escaped reference, z itself is now the delta to Z_0 = 0
+            return x_iterate_double(orbit_, bla_, fe_to_double(dcx_), fe_to_double(dcy_), _x, _y, 0, _iter + 1, max_iter_);
+        }
+
+        if (_e > FE_RESCALE_EXP) {
+            return x_iterate_double(
+                orbit_, bla_, fe_to_double(dcx_), fe_to_double(dcy_),
+                std::ldexp(_wx, _e), std::ldexp(_wy, _e),
+                _n, _iter + 1, max_iter_);
+        }
+    }
+    return {};
+}
+
+/**
+ * @brief Run f_(i) for i in [0, n_), interleaved over one thread per hardware core.
+ */
+template <typename Func>
+void x_parallel_for(int n_, const Func& f_)
+{
+    const int _n_threads = std::max(1, std::min<int>(n_, std::thread::hardware_concurrency()));
+
+    std::vector<std::thread> _threads;
+    for (int _t = 0; _t < _n_threads; ++_t) {
+        _threads.emplace_back([&f_, n_, _t, _n_threads]() {
+            for (int _i = _t; _i < n_; _i += _n_threads) {
+                f_(_i);
+            }
+        });
+    }
+    for (auto& _thread : _threads) {
+        _thread.join();
+    }
+    return;
+}
+
+/**
+ * @brief Plane position in [-1, 1] of pixel index idx_, same mapping as the shader.
+ */
+void x_plane_pos(const Plane_View_t& view_, size_t idx_, double& rout_px_, double& rout_py_)
+{
+    int _i = static_cast<int>(idx_ % view_.wd);
+    int _j = static_cast<int>(idx_ / view_.wd);
+
+    rout_px_ = 2. * (_i + 0.5) / view_.wd - 1.;
+    rout_py_ = 1. - 2. * (_j + 0.5) / view_.ht;
+    return;
+}
+
+/**
+ * @brief Iterate pixel idx_ of the view against orbit_.
+ */
+auto x_render_pixel(
+    const Ref_Orbit_t& orbit_,
+    const Bla_Table_t& bla_,
+    const Plane_View_t& view_,
+    size_t idx_,
+    int max_iter_)-> Pixel_Result_t
+{
+    // offset of the view centre from the reference point
+    const floatExp _offx = dd_sub(view_.cx, orbit_.cx).val;
+    const floatExp _offy = dd_sub(view_.cy, orbit_.cy).val;
+
+    double _px, _py;
+    x_plane_pos(view_, idx_, _px, _py);
+
+    return perturb_pixel(
+        orbit_, &bla_,
+        fe_add(_offx, fe_mul(view_.radius, _px)),
+        fe_add(_offy, fe_mul(view_.radius, _py)),
+        max_iter_);
+}
+
+/**
+ * @brief Group the glitched pixels into 4-connected regions.
+ */
+auto x_glitch_groups(
+    const Plane_View_t& view_,
+    const std::vector<Pixel_Result_t>& pixels_)-> std::vector<std::vector<size_t>>
+{
+    std::vector<std::vector<size_t>> _groups;
+    std::vector<bool> _visited(pixels_.size(), false);
+    std::vector<size_t> _stack;
+
+    for (size_t _seed = 0; _seed < pixels_.size(); ++_seed) {
+        if (!pixels_[_seed].glitched || _visited[_seed]) {
+            continue;
+        }
+
+        // flood fill from the seed
+        std::vector<size_t> _group;
+        _stack.push_back(_seed);
+        _visited[_seed] = true;
+
+        while (!_stack.empty()) {
+            size_t _idx = _stack.back();
+            _stack.pop_back();
+            _group.push_back(_idx);
+
+            int _i = static_cast<int>(_idx % view_.wd);
+            int _j = static_cast<int>(_idx / view_.wd);
+            const int _nb[4][2] = { {_i - 1, _j}, {_i + 1, _j}, {_i, _j - 1}, {_i, _j + 1} };
+
+            for (const auto& [_ni, _nj] : _nb) {
+                if (_ni < 0 || _nj < 0 || _ni >= view_.wd || _nj >= view_.ht) {
+                    continue;
+                }
+                size_t _nidx = size_t(_nj) * view_.wd + _ni;
+                if (pixels_[_nidx].glitched && !_visited[_nidx]) {
+                    _visited[_nidx] = true;
+                    _stack.push_back(_nidx);
+                }
+            }
+        }
+        _groups.push_back(std::move(_group));
+    }
+
+    // largest regions first
+    std::sort(_groups.begin(), _groups.end(),
+        [](const auto& a_, const auto& b_) { return a_.size() > b_.size(); });
+    return _groups;
+}
+
+/**
+ * @brief BLA table of orbit_, for the pixels of view_.
+ */
+void x_build_bla(const Ref_Orbit_t& orbit_, const Plane_View_t& view_, Bla_Table_t& rout_bla_)
+{
+    // largest |dc|, from the reference to the farthest corner of the view
+    double _off = std::hypot(
+        dd_sub(view_.cx, orbit_.cx).val,
+        dd_sub(view_.cy, orbit_.cy).val);
+    double _dc_max = _off + std::sqrt(2.) * fe_to_double(view_.radius);
+
+    build_bla_table(orbit_, _dc_max, BLA_EPS, rout_bla_);
+    return;
+}
+
+} // namespace
+
+
+/**
+ * @brief Computes the reference orbit at c = (cx_, cy_) in double-double.
+ *
+ * @param[in] cx_  reference point, real part
+ * @param[in] cy_  reference point, imaginary part
+ * @param[in] max_iter_  iteration limit
+ * @param[out] rout_orbit_  the orbit, Z_0 .. Z_n with n <= max_iter_ + 1
+ */
+void compute_reference_orbit(
+    const deuxDouble& cx_,
+    const deuxDouble& cy_,
+    int max_iter_,
+    Ref_Orbit_t& rout_orbit_)
+{
+    rout_orbit_.cx = cx_;
+    rout_orbit_.cy = cy_;
+    rout_orbit_.zx = deuxDouble();
+    rout_orbit_.zy = deuxDouble();
+    rout_orbit_.max_iter = max_iter_;
+    rout_orbit_.escaped = false;
+
+    rout_orbit_.points.clear();
+    rout_orbit_.points.reserve(max_iter_ + 2);
+    rout_orbit_.points.push_back({ 0., 0. });
+
+    x_iterate_reference(rout_orbit_, max_iter_);
+    return;
+}
+
+/**
+ * @brief Extends a reference orbit to a higher iteration limit.
+ *
+ *  The first points stay valid, iteration resumes from the last z kept in
+ *  double-double, so only the new points are computed. An escaped orbit, or
+ *  a lower limit, leaves the points as they are.
+ *
+ * @param[in] max_iter_  new iteration limit
+ * @param[in,out] rio_orbit_  the orbit, as computed by compute_reference_orbit()
+ */
+void extend_reference_orbit(int max_iter_, Ref_Orbit_t& rio_orbit_)
+{
+    if (max_iter_ <= rio_orbit_.max_iter) {
+        return;
+    }
+    rio_orbit_.max_iter = max_iter_;
+
+    if (rio_orbit_.escaped) {
+        return;
+    }
+
+    rio_orbit_.points.reserve(max_iter_ + 2);
+    x_iterate_reference(rio_orbit_, max_iter_);
+    return;
+}
+
+/**
+ * @brief Iterates one pixel, at offset (dcx_, dcy_) from the reference point.
+ *
+ * @param[in] orbit_  reference orbit
+ * @param[in] bla_  BLA table of the orbit, or nullptr
+ * @param[in] dcx_  offset from the reference point, real part
+ * @param[in] dcy_  offset from the reference point, imaginary part
+ * @param[in] max_iter_  iteration limit
+ *
+ * @return escape iteration and |z|^2
+ */
+auto perturb_pixel(
+    const Ref_Orbit_t& orbit_,
+    const Bla_Table_t* bla_,
+    const floatExp& dcx_,
+    const floatExp& dcy_,
+    int max_iter_)-> Pixel_Result_t
+{
+    if (std::max(dcx_.exp, dcy_.exp) > FE_RESCALE_EXP) {
+        return x_iterate_double(orbit_, bla_, fe_to_double(dcx_), fe_to_double(dcy_), 0., 0., 0, 0, max_iter_);
+    }
+    return x_iterate_rescaled(orbit_, bla_, dcx_, dcy_, max_iter_);
+}
+
+/**
+ * @brief Renders a view on the CPU, one thread per hardware core.
+ *
+ * @param[in] orbit_  reference orbit, computed at the view centre
+ * @param[in] view_  view to render
+ * @param[in] max_iter_  iteration limit
+ * @param[out] rout_pixels_  per-pixel result, rows top to bottom
+ *
+ * @return number of reference orbits used, and pixels left glitched
+ */
+auto render_perturbation_cpu(
+    const Ref_Orbit_t& orbit_,
+    const Plane_View_t& view_,
+    int max_iter_,
+    std::vector<Pixel_Result_t>& rout_pixels_)-> Render_Stats_t
+{
+    Render_Stats_t _stats;
+    _stats.n_references = 1;
+
+    const int _n_pixels = view_.wd * view_.ht;
+    rout_pixels_.assign(_n_pixels, Pixel_Result_t{});
+
+    Bla_Table_t _bla;
+    x_build_bla(orbit_, view_, _bla);
+
+    x_parallel_for(_n_pixels, [&](int i_) {
+        rout_pixels_[i_] = x_render_pixel(orbit_, _bla, view_, i_, max_iter_);
+    });
+
+    for (int _pass = 0; _pass < MAX_GLITCH_PASSES; ++_pass) {
+
+        auto _groups = x_glitch_groups(view_, rout_pixels_);
+        if (_groups.size() > MAX_REFS_PER_PASS) {
+            _groups.resize(MAX_REFS_PER_PASS);
+        }
+
+        // secondary reference at the most glitched pixel of each group,
+        // groups whose pick is not resolvable from the primary (below the
+        // double-double resolution of the centre) are dropped
+        std::vector<std::pair<deuxDouble, deuxDouble>> _ref_c;
+        std::vector<std::vector<size_t>> _ref_pixels;
+
+        for (auto& _group : _groups) {
+            size_t _pick = *std::min_element(_group.begin(), _group.end(),
+                [&](size_t a_, size_t b_) { return rout_pixels_[a_].dist2 < rout_pixels_[b_].dist2; });
+
+            double _px, _py;
+            x_plane_pos(view_, _pick, _px, _py);
+            deuxDouble _cx = dd_add(view_.cx, fe_to_double(fe_mul(view_.radius, _px)));
+            deuxDouble _cy = dd_add(view_.cy, fe_to_double(fe_mul(view_.radius, _py)));
+
+            if (_cx.val == orbit_.cx.val && _cx.err == orbit_.cx.err
+                && _cy.val == orbit_.cy.val && _cy.err == orbit_.cy.err) {
+                continue;
+            }
+            _ref_c.emplace_back(_cx, _cy);
+            _ref_pixels.push_back(std::move(_group));
+        }
+
+        if (_ref_c.empty()) {
+            break;
+        }
+
+        // reference orbits and their BLA tables in parallel, one per group
+        std::vector<Ref_Orbit_t> _refs(_ref_c.size());
+        std::vector<Bla_Table_t> _ref_blas(_ref_c.size());
+        x_parallel_for(static_cast<int>(_refs.size()), [&](int r_) {
+            compute_reference_orbit(_ref_c[r_].first, _ref_c[r_].second, max_iter_, _refs[r_]);
+            x_build_bla(_refs[r_], view_, _ref_blas[r_]);
+        });
+        _stats.n_references += static_cast<int>(_refs.size());
+
+        // re-render only the glitched pixels, against their group's reference
+        std::vector<std::pair<int, size_t>> _jobs;
+        for (int _r = 0; _r < int(_ref_pixels.size()); ++_r) {
+            for (size_t _idx : _ref_pixels[_r]) {
+                _jobs.emplace_back(_r, _idx);
+            }
+        }
+
+        x_parallel_for(static_cast<int>(_jobs.size()), [&](int k_) {
+            const auto& [_r, _idx] = _jobs[k_];
+            rout_pixels_[_idx] = x_render_pixel(_refs[_r], _ref_blas[_r], view_, _idx, max_iter_);
+        });
+    }
+
+    _stats.n_glitched = static_cast<int>(
+        std::count_if(rout_pixels_.begin(), rout_pixels_.end(),
+            [](const Pixel_Result_t& px_) { return px_.glitched; }));
+    return _stats;
+}
@@ -25,16 +25,25 @@ Shader::Shader(
     x_add_shader( vertex_shader_path, GL_VERTEX_SHADER);
     x_add_shader( fragment_shader_path, GL_FRAGMENT_SHADER);
 
-    glLinkProgram(m_shader_id);
+    x_link();
+}
 
-    GLint success{}; 
-    glGetProgramiv(m_shader_id, GL_LINK_STATUS, &success);
+/**
+ * @brief Constructor for a compute Shader.
+ *
+ * @param compute_shader_path Path to the compute shader file.
+ */
+Shader::Shader(const std::filesystem::path& compute_shader_path)
+{
+    m_shader_id = glCreateProgram();
 
-    if (!success) {
-        auto error_message = std::array<char, 512>{};
-        glGetProgramInfoLog(m_shader_id, 512, nullptr, error_message.data());
-        std::cout << "Error linking shader program: " << error_message.data() << "\n";
+    if (m_shader_id == 0) {
+        throw std::runtime_error("glCreateProgram() FAIL");
     }
+
+    x_add_shader( compute_shader_path, GL_COMPUTE_SHADER);
+
+    x_link();
 }
 
 /**
@@ -58,6 +67,25 @@ void Shader::x_reset()
     return;
 }
 
+/**
+ * @brief Link function for Shader class, after the shaders are added.
+ */
+void Shader::x_link()
+{
+    glLinkProgram(m_shader_id);
+
+    GLint success{}; 
+    glGetProgramiv(m_shader_id, GL_LINK_STATUS, &success);
+
+    if (!success) {
+        auto error_message = std::array<char, 512>{};
+        glGetProgramInfoLog(m_shader_id, 512, nullptr, error_message.data());
+        std::cout << "Error linking shader program: " << error_message.data() << "\n";
+    }
+
+    return;
+}
+
 /**
  * @brief Use shader function for Shader class.
  */
@@ -173,6 +201,11 @@ void Shader::set_vec2(const std::string& name, float x, float y) const
     glUniform2f(glGetUniformLocation(m_shader_id, name.c_str()), x, y);
 }
 
+void Shader::set_ivec2(const std::string& name, int x, int y) const
+{
+    glUniform2i(glGetUniformLocation(m_shader_id, name.c_str()), x, y);
+}
+
  
 void Shader::set_vec3(const std::string& name, const glm::vec3& value) const
 {
@@ -0,0 +1,237 @@
+#include "shader_kernels.h"
+
+// Note: the shader marks the error-free transformations 'precise', the
+// compiler must not contract them into FMAs here either (default for MSVC
+// /fp:precise, and for GCC/Clang without -ffp-contract=fast).
+
+namespace {
+
+/**
+ * @brief float2 / double2 of the shader
+ */
+template<typename T>
+struct Emdp_t {
+    T x = T(0);
+    T y = T(0);
+};
+
+template<typename T>
+Emdp_t<T> x_emdp_sub(const Emdp_t<T> ds0_, const Emdp_t<T> ds1_)
+{
+    T _t1 = ds0_.x - ds1_.x;
+    T _e = _t1 - ds0_.x;
+
+    T _t2 = ((-ds1_.x - _e) + (ds0_.x - (_t1 - _e))) + ds0_.y - ds1_.y;
+
+    Emdp_t<T> _ds;
+    _ds.x = _e = _t1 + _t2;
+    _ds.y = _t2 - (_e - _t1);
+    return _ds;
+}
+
+template<typename T>
+Emdp_t<T> x_emdp_add(const Emdp_t<T> ds0_, const Emdp_t<T> ds1_)
+{
+    T _x = ds0_.x + ds1_.x;
+    T _ds1_val_virtual = _x - ds0_.x;
+
+    T _y = ((ds1_.x - _ds1_val_virtual) + (ds0_.x - (_x - _ds1_val_virtual))) + ds0_.y + ds1_.y;
+
+    Emdp_t<T> _ds;
+    _ds.x = _x + _y;
+    _ds.y = _y - (_ds.x - _x);
+    return _ds;
+}
+
+/**
+ * @brief Dekker split constant, 2^13 + 1 for float, 2^27 + 1 for double
+ */
+template<typename T>
+constexpr T x_split()
+{
+    return (sizeof(T) == sizeof(float)) ? T(8193) : T(134217729);
+}
+
+template<typename T>
+Emdp_t<T> x_emdp_mul(const Emdp_t<T> ds0_, const Emdp_t<T> ds1_)
+{
+    T cona = ds0_.x * x_split<T>();
+    T conb = ds1_.x * x_split<T>();
+    T a1 = cona - (cona - ds0_.x);
+    T b1 = conb - (conb - ds1_.x);
+
+    T a2 = ds0_.x - a1;
+    T b2 = ds1_.x - b1;
+
+    T c11 = ds0_.x * ds1_.x;
+    T c21 = (((a1 * b1 - c11) + (a1 * b2)) + (a2 * b1)) + (a2 * b2);
+
+    T c2 = (ds0_.x * ds1_.y) + (ds0_.y * ds1_.x);
+
+    T t1 = c2 + c11;
+    T e = t1 - c11;
+    T t2 = ((c2 - e) + (c11 - (t1 - e))) + c21;
+
+    t2 = t2 + (ds0_.y * ds1_.y);
+
+    Emdp_t<T> _ds;
+    _ds.x = t1 + t2;
+    _ds.y = t2 - (_ds.x - t1);
+    return _ds;
+}
+
+template<typename T>
+Emdp_t<T> x_emdp_scale(const Emdp_t<T> ds0_, const float sc_)
+{
+    T cona = ds0_.x * x_split<T>();
+    T conb = T(sc_ * 8193.f); // float product, sc_ is a float in both versions
+
+    T a1 = cona - (cona - ds0_.x);
+    T b1 = conb - (conb - sc_);
+
+    T a2 = ds0_.x - a1;
+    T b2 = sc_ - b1;
+
+    T c11 = ds0_.x * sc_;
+    T err3 = (c11 - (a1 * b1)) - (a2 * b1) - (a1 * b2);
+    T c21 = (a2 * b2) - err3;
+
+    T c2 = (ds0_.y * sc_);
+
+    T t1 = c2 + c11;
+    T e = t1 - c11;
+    T t2 = ((c2 - e) + (c11 - (t1 - e))) + c21;
+
+    Emdp_t<T> _ds;
+    _ds.x = t1 + t2;
+    _ds.y = t2 - (_ds.x - t1);
+    return _ds;
+}
+
+/**
+ * @brief Body of render_01_ds() (T = float) and render_01_dd() (T = double).
+ */
+template<typename T>
+auto x_render_01_emdp(float px_, float py_, const Shader_Uniforms_t& u_)-> Pixel_Result_t
+{
+    Emdp_t<T> _t1x{ T(px_ * 2.f), T(0) };
+    Emdp_t<T> _t1y{ T(py_ * 2.f), T(0) };
+
+    _t1x = x_emdp_scale(_t1x, u_.zoom);
+    _t1y = x_emdp_scale(_t1y, u_.zoom);
+
+    Emdp_t<T> _ds_cx = x_emdp_add(_t1x, Emdp_t<T>{ T(u_.ds_cam_x[0]), T(u_.ds_cam_x[1]) });
+    Emdp_t<T> _ds_cy = x_emdp_add(_t1y, Emdp_t<T>{ T(u_.ds_cam_y[0]), T(u_.ds_cam_y[1]) });
+
+    Emdp_t<T> _ds_zx = _ds_cx;
+    Emdp_t<T> _ds_zy = _ds_cy;
+
+    Pixel_Result_t _px;
+    int _iter = 0;
+
+    Emdp_t<T> _ds_dist_x = x_emdp_mul(_ds_zx, _ds_zx);
+    Emdp_t<T> _ds_dist_y = x_emdp_mul(_ds_zy, _ds_zy);
+
+    while (float(_iter) < u_.max_iter) {
+        Emdp_t<T> _dist0 = x_emdp_add(_ds_dist_x, _ds_dist_y);
+
+        if (_dist0.x > T(4)) {
+            _px.iter = _iter;
+            _px.dist2 = static_cast<float>(_dist0.x);
+            break;
+        }
+
+        _ds_zy = x_emdp_mul(_ds_zx, _ds_zy);
+        _ds_zy = x_emdp_add(_ds_zy, _ds_zy);
+        _ds_zy = x_emdp_add(_ds_zy, _ds_cy);
+
+        _ds_zx = x_emdp_sub(_ds_dist_x, _ds_dist_y);
+        _ds_zx = x_emdp_add(_ds_zx, _ds_cx);
+
+        _ds_dist_x = x_emdp_mul(_ds_zx, _ds_zx);
+        _ds_dist_y = x_emdp_mul(_ds_zy, _ds_zy);
+
+        ++_iter;
+    }
+    return _px;
+}
+
+} // namespace
+
+
+/**
+ * @brief Fills the uniforms the same way as main.cpp does.
+ *
+ * @param[in] cam_x_, cam_y_  camera position
+ * @param[in] zoom_  cameraZoom
+ * @param[in] max_iter_  iteration limit
+ * @param[out] rout_u_  the uniforms
+ */
+void set_shader_uniforms(
+    double cam_x_,
+    double cam_y_,
+    double zoom_,
+    int max_iter_,
+    Shader_Uniforms_t& rout_u_)
+{
+    // same split as double_to_ds() in main.cpp
+    rout_u_.ds_cam_x[0] = static_cast<float>(cam_x_);
+    rout_u_.ds_cam_x[1] = static_cast<float>(cam_x_ - rout_u_.ds_cam_x[0]);
+    rout_u_.ds_cam_y[0] = static_cast<float>(cam_y_);
+    rout_u_.ds_cam_y[1] = static_cast<float>(cam_y_ - rout_u_.ds_cam_y[0]);
+
+    rout_u_.zoom = static_cast<float>(1. / zoom_);
+    rout_u_.max_iter = float(max_iter_);
+    return;
+}
+
+/**
+ * @brief CPU mirror of render_01_std(), single precision.
+ */
+auto shader_render_01_std(float px_, float py_, const Shader_Uniforms_t& u_)-> Pixel_Result_t
+{
+    float _cx = (2.f * u_.zoom) * px_ + u_.ds_cam_x[0];
+    float _cy = (2.f * u_.zoom) * py_ + u_.ds_cam_y[0];
+    float _zx = _cx;
+    float _zy = _cy;
+
+    Pixel_Result_t _px;
+    int _iter = 0;
+
+    // hadamard product z o z
+    float _zozx = _zx * _zx;
+    float _zozy = _zy * _zy;
+
+    while (float(_iter) < u_.max_iter) {
+        float _dist = _zozx + _zozy;
+
+        if (_dist > 4.f) {
+            _px.iter = _iter;
+            _px.dist2 = _dist;
+            break;
+        }
+
+        _zy = 2.f * (_zx * _zy) + _cy;
+        _zx = (_zozx - _zozy) + _cx;
+        _zozx = _zx * _zx;
+        _zozy = _zy * _zy;
+        ++_iter;
+    }
+    return _px;
+}
+
+/**
+ * @brief CPU mirror of render_01_ds(), emulated double-single.
+ */
+auto shader_render_01_ds(float px_, float py_, const Shader_Uniforms_t& u_)-> Pixel_Result_t
+{
+    return x_render_01_emdp<float>(px_, py_, u_);
+}
+
+/**
+ * @brief CPU mirror of render_01_dd(), emulated double-double.
+ */
+auto shader_render_01_dd(float px_, float py_, const Shader_Uniforms_t& u_)-> Pixel_Result_t
+{
+    return x_render_01_emdp<double>(px_, py_, u_);
+}